@@ -5,10 +5,133 @@
 
 // <code>
 #include <iostream> // cin, cout
+#include <chrono>
+#include <string>
+#include <vector>
+#include <alsa/asoundlib.h>
 #include <speechapi_cxx.h>
 
 using namespace std;
 using namespace Microsoft::CognitiveServices::Speech;
+using namespace Microsoft::CognitiveServices::Speech::Audio;
+
+// Synthesizes through a pull output stream into a small-buffer ALSA playback
+// loop and reports the time from SpeakTextAsync to the first audio chunk and
+// to the first sample handed to the playback device. This measures time to
+// first byte in-process, on target hardware, instead of pointing a microphone
+// at the speaker.
+void synthesizeSpeechToAlsaPlayback()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Raw PCM so the pull stream carries samples only, no container header.
+    config->SetSpeechSynthesisOutputFormat(SpeechSynthesisOutputFormat::Raw16Khz16BitMonoPcm);
+
+    auto pullStream = AudioOutputStream::CreatePullStream();
+    auto synthesizer = SpeechSynthesizer::FromConfig(config, AudioConfig::FromStreamOutput(pullStream));
+
+    // Opens the playback device before synthesis starts so device setup time
+    // does not pollute the latency measurement. The buffer is kept small
+    // (four 10 ms periods) so the first write becomes audible quickly.
+    snd_pcm_t* playback = NULL;
+    if (snd_pcm_open(&playback, "default", SND_PCM_STREAM_PLAYBACK, 0) < 0)
+    {
+        cout << "Error: could not open the default ALSA playback device" << std::endl;
+        return;
+    }
+
+    const unsigned int sampleRate = 16000;
+    snd_pcm_uframes_t periodFrames = 160;
+    snd_pcm_hw_params_t* hwParams = NULL;
+    snd_pcm_hw_params_alloca(&hwParams);
+    snd_pcm_hw_params_any(playback, hwParams);
+    snd_pcm_hw_params_set_access(playback, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED);
+    snd_pcm_hw_params_set_format(playback, hwParams, SND_PCM_FORMAT_S16_LE);
+    snd_pcm_hw_params_set_channels(playback, hwParams, 1);
+    unsigned int actualRate = sampleRate;
+    snd_pcm_hw_params_set_rate_near(playback, hwParams, &actualRate, NULL);
+    snd_pcm_hw_params_set_period_size_near(playback, hwParams, &periodFrames, NULL);
+    snd_pcm_uframes_t bufferFrames = periodFrames * 4;
+    snd_pcm_hw_params_set_buffer_size_near(playback, hwParams, &bufferFrames);
+    if (snd_pcm_hw_params(playback, hwParams) < 0)
+    {
+        cout << "Error: could not apply the ALSA playback parameters" << std::endl;
+        snd_pcm_close(playback);
+        return;
+    }
+
+    // Receive a text from console input and synthesize it to the device.
+    cout << "Type some text that you want to speak..." << std::endl;
+    cout << "> ";
+    std::string text;
+    getline(cin, text);
+
+    auto speakStart = chrono::steady_clock::now();
+    auto speakFuture = synthesizer->SpeakTextAsync(text);
+
+    vector<uint8_t> buffer(periodFrames * sizeof(int16_t));
+    bool firstChunk = true;
+    for (;;)
+    {
+        // Blocks until the service has produced the next chunk.
+        uint32_t filled = pullStream->Read(buffer.data(), (uint32_t)buffer.size());
+        if (filled == 0)
+        {
+            break;
+        }
+
+        if (firstChunk)
+        {
+            cout << "First audio chunk after "
+                 << chrono::duration<double, milli>(chrono::steady_clock::now() - speakStart).count()
+                 << " ms" << std::endl;
+        }
+
+        snd_pcm_sframes_t frames = snd_pcm_writei(playback, buffer.data(), filled / sizeof(int16_t));
+        if (frames < 0)
+        {
+            frames = snd_pcm_recover(playback, (int)frames, 1);
+            if (frames < 0)
+            {
+                break;
+            }
+        }
+
+        if (firstChunk)
+        {
+            firstChunk = false;
+            cout << "First samples queued on the device after "
+                 << chrono::duration<double, milli>(chrono::steady_clock::now() - speakStart).count()
+                 << " ms (device buffer " << (bufferFrames * 1000.0 / actualRate) << " ms)" << std::endl;
+        }
+    }
+
+    // Lets the last periods play out before closing the device.
+    snd_pcm_drain(playback);
+    snd_pcm_close(playback);
+
+    auto result = speakFuture.get();
+
+    // Checks result.
+    if (result->Reason == ResultReason::SynthesizingAudioCompleted)
+    {
+        cout << "Speech synthesized to ALSA playback for text [" << text << "]" << std::endl;
+    }
+    else if (result->Reason == ResultReason::Canceled)
+    {
+        auto cancellation = SpeechSynthesisCancellationDetails::FromResult(result);
+        cout << "CANCELED: Reason=" << (int)cancellation->Reason << std::endl;
+
+        if (cancellation->Reason == CancellationReason::Error)
+        {
+            cout << "CANCELED: ErrorCode=" << (int)cancellation->ErrorCode << std::endl;
+            cout << "CANCELED: ErrorDetails=[" << cancellation->ErrorDetails << "]" << std::endl;
+            cout << "CANCELED: Did you update the subscription info?" << std::endl;
+        }
+    }
+}
 
 void synthesizeSpeech()
 {
@@ -52,7 +175,17 @@ void synthesizeSpeech()
 
 int main(int argc, char **argv) {
     setlocale(LC_ALL, "");
-    synthesizeSpeech();
+
+    // "alsa" selects the pull-stream playback path with latency reporting;
+    // with no arguments the SDK's default speaker output is used as before.
+    if (argc > 1 && string(argv[1]) == "alsa")
+    {
+        synthesizeSpeechToAlsaPlayback();
+    }
+    else
+    {
+        synthesizeSpeech();
+    }
     return 0;
 }
 // </code>
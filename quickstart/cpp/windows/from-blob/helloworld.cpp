@@ -7,12 +7,17 @@
 #include <iostream>
 #include <strstream>
 #include <Windows.h>
-#include <locale>
-#include <codecvt>
+#include <agents.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <sstream>
 #include <string>
 
 #include <cpprest/http_client.h>
 #include <cpprest/filestream.h>
+#include <cpprest/interopstream.h>
 #include <nlohmann/json.hpp>
 
 using namespace std;
@@ -23,6 +28,149 @@ using namespace web::http::client;          // HTTP client features
 using namespace concurrency::streams;       // Asynchronous streams
 using json = nlohmann::json;
 
+// UTF-8 <-> UTF-16 conversion for utility::string_t boundary crossings.
+// std::wstring_convert is deprecated and slow enough (tens of MB/s) to show
+// up above the JSON parser when result downloads are large. Service payloads
+// are overwhelmingly ASCII, so both directions run an SSE2 bulk path that
+// widens or narrows 8-16 units per iteration, dropping to per-code-point
+// handling (including surrogate pairs) only around non-ASCII input.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define UTF_CONVERT_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace utf
+{
+    inline std::string ToUtf8(const std::wstring& utf16)
+    {
+        std::string utf8;
+        utf8.reserve(utf16.size());
+        size_t i = 0;
+        const size_t count = utf16.size();
+        while (i < count)
+        {
+#ifdef UTF_CONVERT_USE_SSE2
+            // Bulk path: narrow 8 units at a time while every unit is ASCII.
+            while (i + 8 <= count)
+            {
+                __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16.data() + i));
+                __m128i nonAscii = _mm_and_si128(units, _mm_set1_epi16((short)0xFF80));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) != 0xFFFF)
+                {
+                    break;
+                }
+                char bytes[16];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), _mm_packus_epi16(units, _mm_setzero_si128()));
+                utf8.append(bytes, 8);
+                i += 8;
+            }
+            if (i >= count)
+            {
+                break;
+            }
+#endif
+            uint32_t codePoint = utf16[i++];
+            if (codePoint >= 0xD800 && codePoint < 0xDC00 && i < count &&
+                utf16[i] >= 0xDC00 && utf16[i] < 0xE000)
+            {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (utf16[i++] - 0xDC00);
+            }
+
+            if (codePoint < 0x80)
+            {
+                utf8.push_back((char)codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                utf8.push_back((char)(0xC0 | (codePoint >> 6)));
+                utf8.push_back((char)(0x80 | (codePoint & 0x3F)));
+            }
+            else if (codePoint < 0x10000)
+            {
+                utf8.push_back((char)(0xE0 | (codePoint >> 12)));
+                utf8.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+                utf8.push_back((char)(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                utf8.push_back((char)(0xF0 | (codePoint >> 18)));
+                utf8.push_back((char)(0x80 | ((codePoint >> 12) & 0x3F)));
+                utf8.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+                utf8.push_back((char)(0x80 | (codePoint & 0x3F)));
+            }
+        }
+        return utf8;
+    }
+
+    inline std::wstring ToUtf16(const std::string& utf8)
+    {
+        std::wstring utf16;
+        utf16.reserve(utf8.size());
+        size_t i = 0;
+        const size_t count = utf8.size();
+        while (i < count)
+        {
+#ifdef UTF_CONVERT_USE_SSE2
+            // Bulk path: widen 16 bytes at a time while every byte is ASCII.
+            while (i + 16 <= count)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8.data() + i));
+                if (_mm_movemask_epi8(bytes) != 0)
+                {
+                    break;
+                }
+                wchar_t units[16];
+                __m128i zero = _mm_setzero_si128();
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(units), _mm_unpacklo_epi8(bytes, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(units + 8), _mm_unpackhi_epi8(bytes, zero));
+                utf16.append(units, 16);
+                i += 16;
+            }
+            if (i >= count)
+            {
+                break;
+            }
+#endif
+            unsigned char lead = (unsigned char)utf8[i];
+            if (lead < 0x80)
+            {
+                utf16.push_back((wchar_t)lead);
+                i++;
+            }
+            else if ((lead >> 5) == 0x6 && i + 1 < count)
+            {
+                utf16.push_back((wchar_t)(((lead & 0x1F) << 6) | ((unsigned char)utf8[i + 1] & 0x3F)));
+                i += 2;
+            }
+            else if ((lead >> 4) == 0xE && i + 2 < count)
+            {
+                utf16.push_back((wchar_t)(((lead & 0x0F) << 12) |
+                    (((unsigned char)utf8[i + 1] & 0x3F) << 6) |
+                    ((unsigned char)utf8[i + 2] & 0x3F)));
+                i += 3;
+            }
+            else if ((lead >> 3) == 0x1E && i + 3 < count)
+            {
+                uint32_t codePoint = (((uint32_t)lead & 0x07) << 18) |
+                    (((unsigned char)utf8[i + 1] & 0x3F) << 12) |
+                    (((unsigned char)utf8[i + 2] & 0x3F) << 6) |
+                    ((unsigned char)utf8[i + 3] & 0x3F);
+                codePoint -= 0x10000;
+                utf16.push_back((wchar_t)(0xD800 + (codePoint >> 10)));
+                utf16.push_back((wchar_t)(0xDC00 + (codePoint & 0x3FF)));
+                i += 4;
+            }
+            else
+            {
+                // Truncated or malformed sequence: substitute and move on.
+                utf16.push_back((wchar_t)0xFFFD);
+                i++;
+            }
+        }
+        return utf16;
+    }
+}
+
 const string_t region = U("YourServiceRegion");
 const string_t subscriptionKey = U("YourSubscriptionKey");
 const string name = "Simple transcription";
@@ -30,6 +178,13 @@ const string description = "Simple transcription description";
 const string myLocale = "en-US";
 const string recordingsBlobUri = "YourFileUrl";
 
+// Optional local-upload stage: point localAudioFile at a WAV on disk and
+// blobContainerSasUrl at a container SAS URL (with write permission) to have
+// the quickstart stream the file into blob storage itself before submitting,
+// instead of requiring the audio to be staged in advance.
+const string localAudioFile = "YourLocalWavFile";
+const string_t blobContainerSasUrl = U("YourBlobContainerSasUrl");
+
 class TranscriptionDefinition {
 private:
     TranscriptionDefinition(string name,
@@ -127,176 +282,607 @@ public:
     string MaskedITN;
     string Display;
 };
-void from_json(const nlohmann::json& j, Result& r) {
-    j.at("Lexical").get_to(r.Lexical);
-    j.at("ITN").get_to(r.ITN);
-    j.at("MaskedITN").get_to(r.MaskedITN);
-    j.at("Display").get_to(r.Display);
-}
 
 class NBest : public Result
 {
 public:
-    double Confidence;
+    double Confidence = 0;
 };
-void from_json(const nlohmann::json& j, NBest& nb) {
-    j.at("Confidence").get_to(nb.Confidence);
-    j.at("Lexical").get_to(nb.Lexical);
-    j.at("ITN").get_to(nb.ITN);
-    j.at("MaskedITN").get_to(nb.MaskedITN);
-    j.at("Display").get_to(nb.Display);
-}
 
 class SegmentResult
 {
 public:
     string RecognitionStatus;
-    ULONG Offset;
-    ULONG Duration;
+    ULONG Offset = 0;
+    ULONG Duration = 0;
     std::list<NBest> NBest;
 };
-void from_json(const nlohmann::json& j, SegmentResult& sr) {
-    j.at("RecognitionStatus").get_to(sr.RecognitionStatus);
-    j.at("Offset").get_to(sr.Offset);
-    j.at("Duration").get_to(sr.Duration);
-    sr.NBest = j.at("NBest").get<list<NBest>>();
-}
 
-class AudioFileResult
+// SAX handler that extracts SegmentResult records (with their NBest lists)
+// from a batch transcription result as the parser walks it and hands each
+// completed record to a callback. Nothing else of the document is retained,
+// so peak memory is one segment regardless of how many hours the result
+// covers — a multi-hour recording yields result JSON in the hundreds of
+// megabytes, which a DOM parse would hold twice over.
+class SegmentResultSaxHandler final : public nlohmann::json::json_sax_t
 {
 public:
-    string AudioFileName;
-    std::list<SegmentResult> SegmentResults;
-    std::list<Result> CombinedResults;
-};
-void from_json(const nlohmann::json& j, AudioFileResult& arf) {
-    j.at("AudioFileName").get_to(arf.AudioFileName);
-    arf.SegmentResults = j.at("SegmentResults").get<list<SegmentResult>>();
-    arf.CombinedResults = j.at("CombinedResults").get<list<Result>>();
-}
+    // std::string spelled out: inside this class the unqualified name
+    // 'string' refers to the inherited string() event method.
+    typedef std::function<void(const std::string& audioFileName, const SegmentResult&)> SegmentHandler;
 
-class RootObject {
-public:
-    std::list<AudioFileResult> AudioFileResults;
-};
-void from_json(const nlohmann::json& j, RootObject& r) {
-    r.AudioFileResults = j.at("AudioFileResults").get<list<AudioFileResult>>();
-}
+    explicit SegmentResultSaxHandler(SegmentHandler handler)
+        : m_handler(std::move(handler))
+    {
+    }
 
+    bool key(string_t& val) override
+    {
+        m_currentKey = val;
+        return true;
+    }
 
-void recognizeSpeech()
-{
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t >> converter;
+    bool start_object(std::size_t) override
+    {
+        m_depth++;
+        if (m_inNBest && m_depth == m_nbestDepth + 1)
+        {
+            m_nbest = NBest();
+        }
+        else if (m_inSegments && m_depth == m_segmentDepth + 1)
+        {
+            m_segment = SegmentResult();
+        }
+        return true;
+    }
 
-    utility::string_t service_url = U("https://") + region + U(".cris.ai/api/speechtotext/v2.0/Transcriptions/");
-    uri u(service_url);
+    bool end_object() override
+    {
+        if (m_inNBest && m_depth == m_nbestDepth + 1)
+        {
+            m_segment.NBest.push_back(m_nbest);
+        }
+        else if (m_inSegments && m_depth == m_segmentDepth + 1)
+        {
+            m_handler(m_audioFileName, m_segment);
+        }
+        m_depth--;
+        return true;
+    }
 
-    http_client c(u);
-    http_request msg(methods::POST);
-    msg.headers().add(U("Content-Type"), U("application/json"));
-    msg.headers().add(U("Ocp-Apim-Subscription-Key"), subscriptionKey);
+    bool start_array(std::size_t) override
+    {
+        m_depth++;
+        if (m_inSegments && !m_inNBest && m_currentKey == "NBest")
+        {
+            m_inNBest = true;
+            m_nbestDepth = m_depth;
+        }
+        else if (!m_inSegments && m_currentKey == "SegmentResults")
+        {
+            m_inSegments = true;
+            m_segmentDepth = m_depth;
+        }
+        return true;
+    }
 
-    auto transportdef = TranscriptionDefinition::Create(name, description, myLocale, recordingsBlobUri);
+    bool end_array() override
+    {
+        if (m_inNBest && m_depth == m_nbestDepth)
+        {
+            m_inNBest = false;
+        }
+        else if (m_inSegments && m_depth == m_segmentDepth)
+        {
+            m_inSegments = false;
+        }
+        m_depth--;
+        return true;
+    }
 
-    nlohmann::json transportdefJSON = transportdef;
+    bool string(string_t& val) override
+    {
+        if (m_inNBest)
+        {
+            if (m_currentKey == "Lexical") m_nbest.Lexical = val;
+            else if (m_currentKey == "ITN") m_nbest.ITN = val;
+            else if (m_currentKey == "MaskedITN") m_nbest.MaskedITN = val;
+            else if (m_currentKey == "Display") m_nbest.Display = val;
+        }
+        else if (m_inSegments)
+        {
+            if (m_currentKey == "RecognitionStatus") m_segment.RecognitionStatus = val;
+        }
+        else if (m_currentKey == "AudioFileName")
+        {
+            m_audioFileName = val;
+        }
+        return true;
+    }
 
-    msg.set_body(transportdefJSON.dump());
+    bool number_unsigned(number_unsigned_t val) override
+    {
+        if (m_inSegments && !m_inNBest)
+        {
+            if (m_currentKey == "Offset") m_segment.Offset = (ULONG)val;
+            else if (m_currentKey == "Duration") m_segment.Duration = (ULONG)val;
+        }
+        return true;
+    }
 
-    auto response = c.request(msg).get();
-    auto statusCode = response.status_code();
+    bool number_integer(number_integer_t val) override
+    {
+        return number_unsigned((number_unsigned_t)val);
+    }
 
-    if (statusCode != status_codes::Accepted)
+    bool number_float(number_float_t val, const string_t&) override
     {
-        cout << "Unexpected status code " << statusCode << endl;
-        return;
+        if (m_inNBest && m_currentKey == "Confidence")
+        {
+            m_nbest.Confidence = val;
+        }
+        return true;
     }
 
-    string_t transcriptionLocation = response.headers()[U("location")];
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
 
-    cout << "Transcription status is located at " << converter.to_bytes(transcriptionLocation) << endl;
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override
+    {
+        std::ostringstream message;
+        message << "Result parse error at byte " << position << ": " << ex.what();
+        throw std::runtime_error(message.str());
+    }
 
-    http_client statusCheckClient(transcriptionLocation);
-    http_request statusCheckMessage(methods::GET);
-    statusCheckMessage.headers().add(U("Ocp-Apim-Subscription-Key"), subscriptionKey);
+private:
+    SegmentHandler m_handler;
+    std::string m_currentKey;
+    std::string m_audioFileName;
+    SegmentResult m_segment;
+    NBest m_nbest;
+    int m_depth = 0;
+    int m_segmentDepth = 0;
+    int m_nbestDepth = 0;
+    bool m_inSegments = false;
+    bool m_inNBest = false;
+};
 
-    bool completed = false;
 
-    while (!completed)
+// Shares one http_client per scheme://host:port across submission, status
+// polling, and result download. cpprest keeps connections alive per client
+// instance, so constructing a fresh client for every poll pays a TCP+TLS
+// handshake each time; routing the nightly batch's thousands of polls through
+// pooled clients removes minutes of pure handshake time.
+class HttpClientPool
+{
+public:
+    static HttpClientPool& Shared()
     {
-        auto statusResponse = statusCheckClient.request(statusCheckMessage).get();
-        auto statusResponseCode = statusResponse.status_code();
+        static HttpClientPool pool;
+        return pool;
+    }
 
-        if (statusResponseCode != status_codes::OK)
+    // Returns the pooled client for the URL's origin and sets 'pathAndQuery'
+    // to the part of the URL to pass as the request URI on that client.
+    std::shared_ptr<http_client> Get(const uri& address, string_t& pathAndQuery)
+    {
+        uri_builder origin;
+        origin.set_scheme(address.scheme());
+        origin.set_host(address.host());
+        origin.set_port(address.port());
+        string_t key = origin.to_string();
+        pathAndQuery = address.resource().to_string();
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto found = m_clients.find(key);
+        if (found != m_clients.end())
         {
-            cout << "Fetching the transcription returned unexpected http code " << statusResponseCode << endl;
-            return;
+            return found->second;
         }
+        auto client = std::make_shared<http_client>(uri(key));
+        m_clients.emplace(key, client);
+        return client;
+    }
 
-        auto body = statusResponse.extract_string().get();
-        auto statusJSON = nlohmann::json::parse(body);
-        Transcription transcriptionStatus = statusJSON;
+private:
+    HttpClientPool() = default;
 
-        if (!_stricmp(transcriptionStatus.status.c_str(), "Failed"))
+    std::mutex m_mutex;
+    std::map<string_t, std::shared_ptr<http_client>> m_clients;
+};
+
+// Streams a local file into a block blob in large aligned chunks and returns
+// the blob URL (including the container's SAS query) to hand to the
+// transcription service. Reads go through cpprest's asynchronous file stream
+// (overlapped I/O on Windows), and the read of chunk N+1 overlaps the upload
+// of chunk N, so the file is read exactly once, straight from disk to blob,
+// with no staging copy.
+string uploadFileToBlob(const string& localFilePath, const string_t& containerSasUrl, const string& blobName)
+{
+    // 4 MB blocks: large enough to amortize per-request overhead, aligned to
+    // the storage service's block granularity.
+    constexpr size_t blockBytes = 4 * 1024 * 1024;
+
+    // Blob URL = container URL + "/" + blob name, preserving the SAS query.
+    uri containerUri(containerSasUrl);
+    uri_builder blobBuilder(containerUri);
+    blobBuilder.append_path(utf::ToUtf16(blobName));
+    string_t blobUrl = blobBuilder.to_string();
+
+    string_t blobPath;
+    auto client = HttpClientPool::Shared().Get(uri(blobUrl), blobPath);
+
+    auto fileStream = concurrency::streams::file_stream<uint8_t>::open_istream(
+        utf::ToUtf16(localFilePath)).get();
+
+    // Reads one block asynchronously; the returned task yields the bytes.
+    auto readBlock = [&fileStream]()
+    {
+        auto buffer = std::make_shared<concurrency::streams::container_buffer<std::vector<uint8_t>>>();
+        return fileStream.read(*buffer, blockBytes).then([buffer](size_t bytesRead)
         {
-            completed = true;
-            cout << "Transcription has failed " << transcriptionStatus.statusMessage << endl;
+            std::vector<uint8_t> block = std::move(buffer->collection());
+            block.resize(bytesRead);
+            return block;
+        });
+    };
+
+    std::vector<string_t> blockIds;
+    size_t blockIndex = 0;
+    auto pendingRead = readBlock();
+    for (;;)
+    {
+        auto block = pendingRead.get();
+        if (block.empty())
+        {
+            break;
         }
-        else if (!_stricmp(transcriptionStatus.status.c_str(), "Succeeded"))
+
+        // Kick off the next read before uploading this block, so disk and
+        // network stay busy at the same time.
+        pendingRead = readBlock();
+
+        // Block ids must be base64 and the same length for every block.
+        char blockIdText[16];
+        sprintf_s(blockIdText, "%010llu", (unsigned long long)blockIndex++);
+        auto blockId = utility::conversions::to_base64(
+            std::vector<unsigned char>(blockIdText, blockIdText + 10));
+        blockIds.push_back(blockId);
+
+        uri_builder blockUri(blobPath);
+        blockUri.append_query(U("comp"), U("block"));
+        blockUri.append_query(U("blockid"), blockId);
+
+        http_request putBlock(methods::PUT);
+        putBlock.set_request_uri(blockUri.to_string());
+        putBlock.set_body(std::move(block));
+
+        auto response = client->request(putBlock).get();
+        if (response.status_code() != status_codes::Created)
         {
-            completed = true;
-            cout << "Success!" << endl;
-            string result = transcriptionStatus.resultsUrls["channel_0"];
-            cout << "Transcription has completed. Results are at " << result << endl;
-            cout << "Fetching results" << endl;
+            std::ostringstream message;
+            message << "Uploading a block returned unexpected http code " << response.status_code();
+            throw std::runtime_error(message.str());
+        }
+    }
+    fileStream.close().get();
+
+    // Commits the uploaded blocks into the blob in order.
+    std::ostringstream blockList;
+    blockList << "<?xml version=\"1.0\" encoding=\"utf-8\"?><BlockList>";
+    for (const auto& blockId : blockIds)
+    {
+        blockList << "<Latest>" << utf::ToUtf8(blockId) << "</Latest>";
+    }
+    blockList << "</BlockList>";
 
-            http_client result_client(converter.from_bytes(result));
-            http_request resultMessage(methods::GET);
-            resultMessage.headers().add(U("Ocp-Apim-Subscription-Key"), subscriptionKey);
+    uri_builder commitUri(blobPath);
+    commitUri.append_query(U("comp"), U("blocklist"));
 
-            auto resultResponse = result_client.request(resultMessage).get();
+    http_request putBlockList(methods::PUT);
+    putBlockList.set_request_uri(commitUri.to_string());
+    putBlockList.headers().add(U("Content-Type"), U("application/xml"));
+    putBlockList.set_body(blockList.str());
 
-            auto responseCode = resultResponse.status_code();
+    auto commitResponse = client->request(putBlockList).get();
+    if (commitResponse.status_code() != status_codes::Created)
+    {
+        std::ostringstream message;
+        message << "Committing the block list returned unexpected http code " << commitResponse.status_code();
+        throw std::runtime_error(message.str());
+    }
 
-            if (responseCode != status_codes::OK)
+    return utf::ToUtf8(blobUrl);
+}
+
+// Creates a task that completes after the given delay without occupying a
+// thread while it waits. This is what lets one supervisor oversee hundreds of
+// in-flight transcriptions: between polls a job exists only as a timer plus a
+// queued continuation, not as a thread sleeping in a loop.
+static pplx::task<void> completeAfter(unsigned int delayMillis)
+{
+    auto tce = std::make_shared<concurrency::task_completion_event<void>>();
+    auto timer = std::make_shared<concurrency::timer<int>>(delayMillis, 0, nullptr, false);
+    auto callback = std::make_shared<concurrency::call<int>>([tce](int)
+    {
+        tce->set();
+    });
+    timer->link_target(callback.get());
+    timer->start();
+
+    // The timer and callback are captured so they live until the task fires.
+    return pplx::create_task(*tce).then([timer, callback]() {});
+}
+
+// Submits batch transcriptions and polls them asynchronously until they reach
+// a terminal state, then hands the final Transcription to the handler given at
+// Submit() time. Polling runs entirely on cpprest task continuations with
+// exponential backoff and jitter, so the number of concurrent jobs is bounded
+// by service quota, not by threads.
+class TranscriptionManager
+{
+public:
+    typedef std::function<void(const Transcription&)> CompletionHandler;
+
+    TranscriptionManager(const utility::string_t& serviceUrl, const utility::string_t& key)
+        : m_serviceUrl(serviceUrl), m_key(key), m_random(std::random_device{}())
+    {
+    }
+
+    // Submits one transcription and returns immediately; the handler runs on a
+    // continuation thread once the job has succeeded or failed.
+    void Submit(const TranscriptionDefinition& definition, CompletionHandler handler)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_outstanding++;
+        }
+
+        nlohmann::json definitionJSON = definition;
+
+        string_t submitPath;
+        auto client = HttpClientPool::Shared().Get(uri(m_serviceUrl), submitPath);
+
+        http_request msg(methods::POST);
+        msg.set_request_uri(submitPath);
+        msg.headers().add(U("Content-Type"), U("application/json"));
+        msg.headers().add(U("Ocp-Apim-Subscription-Key"), m_key);
+        msg.set_body(definitionJSON.dump());
+
+        // WaitAll() keeps the manager alive until every continuation that
+        // captures 'this' has run, so plain pointer capture is safe here.
+        client->request(msg).then([this, handler](http_response response)
+        {
+            if (response.status_code() != status_codes::Accepted)
             {
-                cout << "Fetching the transcription returned unexpected http code " << responseCode << endl;
+                std::ostringstream message;
+                message << "Unexpected status code " << response.status_code();
+                failJob(handler, message.str());
                 return;
             }
 
-            auto resultBody = resultResponse.extract_string().get();
+            string_t transcriptionLocation = response.headers()[U("location")];
+            cout << "Transcription status is located at " << utf::ToUtf8(transcriptionLocation) << endl;
 
-            nlohmann::json resultJSON = nlohmann::json::parse(resultBody);
-            RootObject root = resultJSON;
+            schedulePoll(transcriptionLocation, handler, 0);
+        }).then([this, handler](pplx::task<void> previous)
+        {
+            guardJob(previous, handler);
+        });
+    }
 
-            for (AudioFileResult af : root.AudioFileResults)
+    // Blocks until every submitted job has reached its handler.
+    void WaitAll()
+    {
+        std::unique_lock<std::mutex> guard(m_mutex);
+        m_allDone.wait(guard, [this]() { return m_outstanding == 0; });
+    }
+
+private:
+    void schedulePoll(const string_t& location, CompletionHandler handler, int attempt)
+    {
+        completeAfter(nextDelayMillis(attempt)).then([this, location]()
+        {
+            // Every poll for a given job hits the same origin, so this reuses
+            // one kept-alive connection instead of opening a new one.
+            string_t statusPath;
+            auto statusCheckClient = HttpClientPool::Shared().Get(uri(location), statusPath);
+            http_request statusCheckMessage(methods::GET);
+            statusCheckMessage.set_request_uri(statusPath);
+            statusCheckMessage.headers().add(U("Ocp-Apim-Subscription-Key"), m_key);
+            return statusCheckClient->request(statusCheckMessage);
+        }).then([](http_response statusResponse)
+        {
+            if (statusResponse.status_code() != status_codes::OK)
             {
-                cout << "There were " << af.SegmentResults.size() << " results in " << af.AudioFileName << endl;
+                std::ostringstream message;
+                message << "Fetching the transcription returned unexpected http code " << statusResponse.status_code();
+                throw std::runtime_error(message.str());
+            }
+            return statusResponse.extract_string();
+        }).then([this, location, handler, attempt](string_t body)
+        {
+            auto statusJSON = nlohmann::json::parse(body);
+            Transcription transcriptionStatus = statusJSON;
 
-                for (SegmentResult segResult : af.SegmentResults)
+            if (!_stricmp(transcriptionStatus.status.c_str(), "Failed") ||
+                !_stricmp(transcriptionStatus.status.c_str(), "Succeeded"))
+            {
+                // The job is done regardless of what the handler does with it:
+                // an exception thrown while fetching or parsing results must
+                // not fall through to guardJob, which would invoke the handler
+                // a second time and decrement the job count twice.
+                try
                 {
-                    cout << "Status: " << segResult.RecognitionStatus << endl;
-
-                    if (!_stricmp(segResult.RecognitionStatus.c_str(), "success") && segResult.NBest.size() > 0)
-                    {
-                        cout << "Best text result was: '" << segResult.NBest.front().Display << "'" << endl;
-                    }
+                    handler(transcriptionStatus);
                 }
+                catch (const std::exception& e)
+                {
+                    cout << "Completion handler failed: " << e.what() << endl;
+                }
+                completeJob();
+                return;
             }
+
+            cout << "Transcription status: " << transcriptionStatus.status << endl;
+            schedulePoll(location, handler, attempt + 1);
+        }).then([this, handler](pplx::task<void> previous)
+        {
+            guardJob(previous, handler);
+        });
+    }
+
+    // Exponential backoff capped at one minute, with +/-20% jitter so jobs
+    // submitted together do not poll the service in lockstep.
+    unsigned int nextDelayMillis(int attempt)
+    {
+        double delay = 1000.0;
+        for (int i = 0; i < attempt && delay < 60000.0; i++)
+        {
+            delay *= 2.0;
         }
-        else if (!_stricmp(transcriptionStatus.status.c_str(), "Running"))
+        delay = (std::min)(delay, 60000.0);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        std::uniform_real_distribution<double> jitter(0.8, 1.2);
+        return (unsigned int)(delay * jitter(m_random));
+    }
+
+    // Surfaces any exception thrown in the continuation chain as a failed job
+    // instead of losing it (and the job's WaitAll() count) on a pplx thread.
+    void guardJob(pplx::task<void>& previous, const CompletionHandler& handler)
+    {
+        try
+        {
+            previous.get();
+        }
+        catch (const std::exception& e)
         {
-            cout << "Transcription is running." << endl;
+            failJob(handler, e.what());
         }
-        else if (!_stricmp(transcriptionStatus.status.c_str(), "NotStarted"))
+    }
+
+    void failJob(const CompletionHandler& handler, const string& message)
+    {
+        Transcription failure;
+        failure.status = "Failed";
+        failure.statusMessage = message;
+        // A throwing handler must not escape onto the pplx thread or skip the
+        // job count; the job completes exactly once either way.
+        try
+        {
+            handler(failure);
+        }
+        catch (const std::exception& e)
+        {
+            cout << "Completion handler failed: " << e.what() << endl;
+        }
+        completeJob();
+    }
+
+    void completeJob()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_outstanding--;
+        }
+        m_allDone.notify_all();
+    }
+
+    string_t m_serviceUrl;
+    string_t m_key;
+    std::mutex m_mutex;
+    std::condition_variable m_allDone;
+    size_t m_outstanding = 0;
+    std::mt19937 m_random;
+};
+
+// Fetches the result document a succeeded transcription points at and prints
+// the per-segment best hypotheses.
+void fetchAndPrintResults(const string& resultsUrl)
+{
+    cout << "Transcription has completed. Results are at " << resultsUrl << endl;
+    cout << "Fetching results" << endl;
+
+    string_t resultPath;
+    auto result_client = HttpClientPool::Shared().Get(uri(utf::ToUtf16(resultsUrl)), resultPath);
+    http_request resultMessage(methods::GET);
+    resultMessage.set_request_uri(resultPath);
+    resultMessage.headers().add(U("Ocp-Apim-Subscription-Key"), subscriptionKey);
+
+    auto resultResponse = result_client->request(resultMessage).get();
+
+    auto responseCode = resultResponse.status_code();
+
+    if (responseCode != status_codes::OK)
+    {
+        cout << "Fetching the transcription returned unexpected http code " << responseCode << endl;
+        return;
+    }
+
+    // Prints each segment as the parser delivers it; no result DOM is built.
+    string currentFile;
+    size_t segmentCount = 0;
+    SegmentResultSaxHandler saxHandler([&currentFile, &segmentCount](const string& audioFileName, const SegmentResult& segResult)
+    {
+        if (audioFileName != currentFile)
         {
-            cout << "Transcription has not started." << endl;
+            currentFile = audioFileName;
+            cout << "Results in " << audioFileName << endl;
         }
+        segmentCount++;
+
+        cout << "Status: " << segResult.RecognitionStatus << endl;
 
-        if (!completed) {
-            Sleep(5000);
+        if (!_stricmp(segResult.RecognitionStatus.c_str(), "success") && segResult.NBest.size() > 0)
+        {
+            cout << "Best text result was: '" << segResult.NBest.front().Display << "'" << endl;
         }
+    });
+
+    // Bridges the async response body to a std::istream so the SAX parse
+    // pulls bytes on demand instead of extracting the whole payload first.
+    concurrency::streams::async_istream<char> resultBodyStream(resultResponse.body());
+    nlohmann::json::sax_parse(resultBodyStream, &saxHandler);
 
+    cout << "There were " << segmentCount << " results." << endl;
+}
+
+void recognizeSpeech()
+{
+    utility::string_t service_url = U("https://") + region + U(".cris.ai/api/speechtotext/v2.0/Transcriptions/");
+
+    TranscriptionManager manager(service_url, subscriptionKey);
+
+    // When a local capture file is configured, stream it into blob storage
+    // first and transcribe the uploaded blob: one pass from disk to submitted
+    // batch job, no external staging tool.
+    string recordingsUrl = recordingsBlobUri;
+    if (localAudioFile != "YourLocalWavFile")
+    {
+        recordingsUrl = uploadFileToBlob(localAudioFile, blobContainerSasUrl, "batch-input.wav");
+        cout << "Uploaded " << localAudioFile << " for transcription" << endl;
     }
+
+    // One definition is submitted here, but Submit() can be called as many
+    // times as needed before WaitAll(): each additional job costs a timer and
+    // queued continuations rather than a dedicated polling thread.
+    manager.Submit(
+        TranscriptionDefinition::Create(name, description, myLocale, recordingsUrl),
+        [](const Transcription& transcriptionStatus)
+    {
+        if (!_stricmp(transcriptionStatus.status.c_str(), "Failed"))
+        {
+            cout << "Transcription has failed " << transcriptionStatus.statusMessage << endl;
+            return;
+        }
+
+        cout << "Success!" << endl;
+        Transcription completed = transcriptionStatus;
+        fetchAndPrintResults(completed.resultsUrls["channel_0"]);
+    });
+
+    manager.WaitAll();
 }
 
 int wmain()
@@ -6,11 +6,130 @@
 #include "stdafx.h"
 // <code>
 #include <iostream>
+#include <string>
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
 #include <speechapi_cxx.h>
 
 using namespace std;
 using namespace Microsoft::CognitiveServices::Speech;
 
+// Local pipe the daemon mode listens on for trigger commands.
+static const char daemonPipeName[] = "\\\\.\\pipe\\speech-quickstart";
+
+// Runs one utterance on an already-created recognizer and formats the outcome
+// as a single reply line.
+string recognizeOnce(const shared_ptr<SpeechRecognizer>& recognizer)
+{
+    auto result = recognizer->RecognizeOnceAsync().get();
+
+    if (result->Reason == ResultReason::RecognizedSpeech)
+    {
+        return "RECOGNIZED: " + result->Text;
+    }
+    if (result->Reason == ResultReason::NoMatch)
+    {
+        return "NOMATCH: Speech could not be recognized.";
+    }
+    if (result->Reason == ResultReason::Canceled)
+    {
+        auto cancellation = CancellationDetails::FromResult(result);
+        return "CANCELED: Reason=" + to_string((int)cancellation->Reason)
+            + " ErrorDetails=" + cancellation->ErrorDetails;
+    }
+    return "ERROR: unexpected result reason";
+}
+
+// Daemon mode: the process stays resident with a pre-created, pre-connected
+// recognizer and serves trigger commands over a local named pipe, so each
+// utterance costs only the recognition itself instead of process start, SDK
+// load, config creation, and connection setup. Trigger with
+// 'helloworld trigger' (push-to-talk) and stop with 'helloworld trigger quit'.
+void runDaemon()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // The recognizer is created once and reused for every trigger.
+    auto recognizer = SpeechRecognizer::FromConfig(config);
+
+    // Pre-opens the service connection so the first trigger does not pay TLS
+    // and websocket setup either. The SDK reopens it if it drops while idle.
+    auto connection = Connection::FromRecognizer(recognizer);
+    connection->Open(false); // false: the connection is used for single-shot recognition.
+
+    cout << "Daemon ready, listening on " << daemonPipeName << std::endl;
+    cout << "Run 'helloworld trigger' to recognize one utterance, 'helloworld trigger quit' to stop." << std::endl;
+
+    bool running = true;
+    while (running)
+    {
+        HANDLE pipe = CreateNamedPipeA(daemonPipeName, PIPE_ACCESS_DUPLEX,
+            PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT, 1, 4096, 4096, 0, nullptr);
+        if (pipe == INVALID_HANDLE_VALUE)
+        {
+            cout << "ERROR: could not create the trigger pipe (error " << GetLastError() << ")" << std::endl;
+            return;
+        }
+
+        // Waits for the next trigger; ERROR_PIPE_CONNECTED means the client
+        // connected between CreateNamedPipe and ConnectNamedPipe.
+        if (!ConnectNamedPipe(pipe, nullptr) && GetLastError() != ERROR_PIPE_CONNECTED)
+        {
+            CloseHandle(pipe);
+            continue;
+        }
+
+        string reply = "ERROR: could not read the command";
+        char commandBuffer[256];
+        DWORD bytesRead = 0;
+        if (ReadFile(pipe, commandBuffer, sizeof(commandBuffer), &bytesRead, nullptr) && bytesRead > 0)
+        {
+            string command(commandBuffer, bytesRead);
+            if (command == "quit")
+            {
+                reply = "BYE";
+                running = false;
+            }
+            else if (command == "recognize")
+            {
+                cout << "Trigger received. Say something..." << std::endl;
+                reply = recognizeOnce(recognizer);
+                cout << reply << std::endl;
+            }
+            else
+            {
+                reply = "ERROR: unknown command '" + command + "'";
+            }
+        }
+
+        DWORD bytesWritten = 0;
+        WriteFile(pipe, reply.data(), (DWORD)reply.size(), &bytesWritten, nullptr);
+        FlushFileBuffers(pipe);
+        DisconnectNamedPipe(pipe);
+        CloseHandle(pipe);
+    }
+}
+
+// Trigger mode: sends one command to the resident daemon and prints its reply.
+void sendTrigger(const string& command)
+{
+    char replyBuffer[4096];
+    DWORD replyBytes = 0;
+    if (CallNamedPipeA(daemonPipeName, (LPVOID)command.data(), (DWORD)command.size(),
+        replyBuffer, sizeof(replyBuffer), &replyBytes, 60 * 1000))
+    {
+        cout << string(replyBuffer, replyBytes) << std::endl;
+    }
+    else
+    {
+        cout << "Could not reach the daemon. Start it first with 'helloworld daemon'." << std::endl;
+    }
+}
+
 void recognizeSpeech()
 {
     // Creates an instance of a speech config with specified subscription key and service region.
@@ -52,10 +171,23 @@ void recognizeSpeech()
     }
 }
 
-int wmain()
+int wmain(int argc, wchar_t* argv[])
 {
     try
     {
+        if (argc > 1 && wcscmp(argv[1], L"daemon") == 0)
+        {
+            // Warm-process mode: stays resident and recognizes on demand.
+            runDaemon();
+            return 0;
+        }
+        if (argc > 1 && wcscmp(argv[1], L"trigger") == 0)
+        {
+            // Client mode: asks the resident daemon for one utterance
+            // (or forwards "quit" to shut it down).
+            sendTrigger(argc > 2 && wcscmp(argv[2], L"quit") == 0 ? "quit" : "recognize");
+            return 0;
+        }
         recognizeSpeech();
     }
     catch (exception e)
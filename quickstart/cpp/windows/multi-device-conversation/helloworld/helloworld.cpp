@@ -3,8 +3,13 @@
 // Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
 //
 
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <speechapi_cxx.h>
 
 using namespace std::chrono_literals;
@@ -12,6 +17,116 @@ using namespace Microsoft::CognitiveServices::Speech;
 using namespace Microsoft::CognitiveServices::Speech::Audio;
 using namespace Microsoft::CognitiveServices::Speech::Transcription;
 
+// Coalesces instant messages: sends queued within a small window leave the
+// room in one SendTextMessageAsync round trip as a newline-separated payload,
+// so high-frequency caption fan-out scales with payload size instead of
+// per-message round trips. Close() (or destruction) flushes anything still
+// queued before returning.
+class BatchingMessageSender
+{
+public:
+    BatchingMessageSender(std::shared_ptr<ConversationTranslator> translator,
+        std::chrono::milliseconds window = std::chrono::milliseconds(50),
+        size_t maxBatchChars = 4096)
+        : m_translator(std::move(translator)), m_window(window), m_maxBatchChars(maxBatchChars)
+    {
+        m_worker = std::thread(&BatchingMessageSender::SendLoop, this);
+    }
+
+    ~BatchingMessageSender()
+    {
+        Close();
+    }
+
+    // Queues one message; returns immediately. Messages are delivered in the
+    // order they were queued.
+    void Send(std::string message)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed)
+            {
+                return;
+            }
+            m_pendingChars += message.size();
+            m_pending.push_back(std::move(message));
+        }
+        m_wake.notify_one();
+    }
+
+    // Drains everything still queued, then stops the worker.
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed)
+            {
+                return;
+            }
+            m_closed = true;
+        }
+        m_wake.notify_all();
+        if (m_worker.joinable())
+        {
+            m_worker.join();
+        }
+    }
+
+private:
+    void SendLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_wake.wait(lock, [this]() { return !m_pending.empty() || m_closed; });
+            if (m_pending.empty() && m_closed)
+            {
+                return;
+            }
+
+            // Coalescing window: keep collecting until it elapses or the
+            // batch is large enough. On close, flush immediately.
+            auto deadline = std::chrono::steady_clock::now() + m_window;
+            while (!m_closed && m_pendingChars < m_maxBatchChars &&
+                m_wake.wait_until(lock, deadline) != std::cv_status::timeout)
+            {
+            }
+
+            std::string batch;
+            batch.reserve(m_pendingChars + m_pending.size());
+            for (size_t i = 0; i < m_pending.size(); i++)
+            {
+                if (i > 0)
+                {
+                    batch += '\n';
+                }
+                batch += m_pending[i];
+            }
+            size_t batchedMessages = m_pending.size();
+            m_pending.clear();
+            m_pendingChars = 0;
+
+            // The actual round trip happens outside the lock, so senders are
+            // never blocked behind the network.
+            lock.unlock();
+            m_translator->SendTextMessageAsync(batch).get();
+            std::cout << "BATCH: Sent " << batchedMessages << " message(s) in one round trip ("
+                << batch.size() << " chars)" << std::endl;
+            lock.lock();
+        }
+    }
+
+    std::shared_ptr<ConversationTranslator> m_translator;
+    std::chrono::milliseconds m_window;
+    size_t m_maxBatchChars;
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::vector<std::string> m_pending;
+    size_t m_pendingChars = 0;
+    bool m_closed = false;
+};
+
 void StartNewConversation()
 {
     // Replace with your own subscription key and service region (e.g., "westus").
@@ -124,8 +239,17 @@ void StartNewConversation()
     // Join the conversation so you can start receiving events
     conversationTranslator->JoinConversationAsync(conversation, "Test Host").get();
 
-    // Send an instant message
-    conversationTranslator->SendTextMessageAsync("This is a short test message").get();
+    // Send instant messages through the coalescing queue: sends queued within
+    // the batching window leave in a single round trip. The sender drains
+    // everything still queued when it goes out of scope.
+    {
+        BatchingMessageSender messageSender(conversationTranslator);
+        messageSender.Send("This is a short test message");
+        for (int i = 0; i < 5; i++)
+        {
+            messageSender.Send("Caption line " + std::to_string(i));
+        }
+    }
 
     // Start sending audio
     conversationTranslator->StartTranscribingAsync().get();
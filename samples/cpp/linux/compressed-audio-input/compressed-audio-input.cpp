@@ -4,93 +4,330 @@
 //
 
 #include <iostream> // cin, cout
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <speechapi_cxx.h>
 
 using namespace Microsoft::CognitiveServices::Speech;
 using namespace Microsoft::CognitiveServices::Speech::Audio;
 
-static void* OpenCompressedFile(const std::string& compressedFileName)
+// Common interface behind the pull stream's read callback; the close callback
+// deletes through it.
+class CompressedInputSource
 {
-    FILE *filep = NULL;
-    filep = fopen(compressedFileName.c_str(), "rb");
-    return filep;
-}
+public:
+    virtual ~CompressedInputSource() {}
+    virtual int Read(uint8_t *ptr, uint32_t bufSize) = 0;
+};
 
-static void closeStream(void* fp)
+// Feeds compressed audio to the SDK's pull callback from a ring of blocks
+// filled by a background reader thread. The GStreamer decode pipeline behind
+// GetCompressedFormat() stalls whenever its pull callback does, so a
+// synchronous fread in the callback puts disk latency on the decode path; with
+// the prefetcher the callback is a memcpy from an already-read block and only
+// waits when the reader genuinely falls behind.
+class CompressedFilePrefetcher : public CompressedInputSource
 {
-    if (fp != NULL)
+public:
+    explicit CompressedFilePrefetcher(const std::string& compressedFileName)
     {
-        fclose((FILE*)fp);
+        m_file = fopen(compressedFileName.c_str(), "rb");
+        if (m_file == NULL)
+        {
+            m_eof = true;
+            return;
+        }
+        m_reader = std::thread(&CompressedFilePrefetcher::ReadLoop, this);
     }
-}
 
-static int ReadCompressedBinaryData(void *stream, uint8_t *ptr, uint32_t bufSize)
-{
-    FILE* compressedStreamfptr = (FILE*)stream;
-    if (compressedStreamfptr != NULL && !feof(compressedStreamfptr))
+    ~CompressedFilePrefetcher() override
     {
-        return fread(ptr, 1, bufSize, compressedStreamfptr);
+        Close();
     }
-    else
+
+    bool IsOpen() const
     {
-        return 0;
+        return m_file != NULL;
+    }
+
+    // Serves the SDK's read callback from prefetched blocks; waits only when
+    // the ring is empty and the reader has not reached end of file yet.
+    int Read(uint8_t *ptr, uint32_t bufSize) override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this]() { return !m_blocks.empty() || m_eof; });
+        if (m_blocks.empty())
+        {
+            return 0;
+        }
+
+        std::vector<uint8_t>& block = m_blocks.front();
+        uint32_t available = (uint32_t)(block.size() - m_frontOffset);
+        uint32_t toCopy = bufSize < available ? bufSize : available;
+        memcpy(ptr, block.data() + m_frontOffset, toCopy);
+        m_frontOffset += toCopy;
+        if (m_frontOffset == block.size())
+        {
+            m_blocks.pop_front();
+            m_frontOffset = 0;
+            m_notFull.notify_one();
+        }
+        return (int)toCopy;
+    }
+
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_eof = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+        if (m_reader.joinable())
+        {
+            m_reader.join();
+        }
+        if (m_file != NULL)
+        {
+            fclose(m_file);
+            m_file = NULL;
+        }
+    }
+
+private:
+    void ReadLoop()
+    {
+        // 256 KB blocks, up to 16 in flight: several seconds of compressed
+        // audio, enough to ride out spinning-disk seek latency.
+        static const size_t blockBytes = 256 * 1024;
+        static const size_t maxBlocks = 16;
+
+        for (;;)
+        {
+            std::vector<uint8_t> block(blockBytes);
+            size_t bytesRead = fread(block.data(), 1, block.size(), m_file);
+            if (bytesRead == 0)
+            {
+                break;
+            }
+            block.resize(bytesRead);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notFull.wait(lock, [this]() { return m_blocks.size() < maxBlocks || m_closed; });
+            if (m_closed)
+            {
+                return;
+            }
+            m_blocks.push_back(std::move(block));
+            m_notEmpty.notify_one();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_eof = true;
+        }
+        m_notEmpty.notify_all();
     }
-}
 
-void recognizeSpeech(const std::string& compressedFileName)
+    FILE *m_file = NULL;
+    std::thread m_reader;
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::deque<std::vector<uint8_t>> m_blocks;
+    size_t m_frontOffset = 0;
+    bool m_eof = false;
+    bool m_closed = false;
+};
+
+// Serves the pull callback directly from a read-only memory mapping of the
+// file: no read copy into a block ring, with MADV_SEQUENTIAL telling the
+// kernel to run its readahead in front of the callback's cursor.
+class MemoryMappedCompressedFile : public CompressedInputSource
 {
-    std::shared_ptr<SpeechRecognizer> recognizer;
-    std::shared_ptr<PullAudioInputStream> pullAudioStream;
+public:
+    explicit MemoryMappedCompressedFile(const std::string& fileName)
+    {
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) == 0 && S_ISREG(fileInfo.st_mode) && fileInfo.st_size > 0)
+        {
+            void* mapping = mmap(NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                m_data = (const uint8_t*)mapping;
+                m_size = (size_t)fileInfo.st_size;
+                madvise(mapping, m_size, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+    }
 
-    void *compressedFilePtr = OpenCompressedFile(compressedFileName);
+    ~MemoryMappedCompressedFile() override
+    {
+        if (m_data != NULL)
+        {
+            munmap((void*)m_data, m_size);
+        }
+    }
 
-    if (compressedFilePtr == NULL)
+    bool IsOpen() const
     {
-        std::cout << "Error: Input file doesn't exist" << std::endl;
-        return;
+        return m_data != NULL;
     }
 
-    // Creates an instance of a speech config with specified subscription key and service region.
-    // Replace with your own subscription key and service region (e.g., "westus").
-    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+    const uint8_t* Data() const
+    {
+        return m_data;
+    }
 
-    AudioStreamContainerFormat inputFormat;
+    size_t Size() const
+    {
+        return m_size;
+    }
 
-    if (compressedFileName.find(".mp3") == (compressedFileName.size() - 4))
+    int Read(uint8_t *ptr, uint32_t bufSize) override
     {
-        inputFormat = AudioStreamContainerFormat::MP3;
+        size_t remaining = m_size - m_offset;
+        uint32_t toCopy = bufSize < remaining ? bufSize : (uint32_t)remaining;
+        memcpy(ptr, m_data + m_offset, toCopy);
+        m_offset += toCopy;
+        return (int)toCopy;
     }
-    else if (compressedFileName.find(".opus") == (compressedFileName.size() - 5))
+
+private:
+    const uint8_t *m_data = NULL;
+    size_t m_size = 0;
+    size_t m_offset = 0;
+};
+
+// Detects the container from the file's leading magic bytes, so extensionless
+// object-store names work. Raw a-law/mu-law input has no header and still
+// relies on the filename extension.
+static bool DetectContainerFormat(const uint8_t *data, size_t size, AudioStreamContainerFormat& format)
+{
+    if (size >= 4 && memcmp(data, "OggS", 4) == 0)
     {
-        inputFormat = AudioStreamContainerFormat::OGG_OPUS;
+        format = AudioStreamContainerFormat::OGG_OPUS;
+        return true;
     }
-    else if (compressedFileName.find(".alaw") == (compressedFileName.size() - 5))
+    if (size >= 4 && memcmp(data, "fLaC", 4) == 0)
     {
-        inputFormat = AudioStreamContainerFormat::ALAW;
+        format = AudioStreamContainerFormat::FLAC;
+        return true;
     }
-    else if (compressedFileName.find(".mulaw") == (compressedFileName.size() - 6))
+    if (size >= 3 && memcmp(data, "ID3", 3) == 0)
     {
-        inputFormat = AudioStreamContainerFormat::MULAW;
+        format = AudioStreamContainerFormat::MP3;
+        return true;
     }
-    else if (compressedFileName.find(".flac") == (compressedFileName.size() - 5))
+    // Untagged MP3: an MPEG audio frame sync word.
+    if (size >= 2 && data[0] == 0xFF && (data[1] & 0xE0) == 0xE0)
     {
-        inputFormat = AudioStreamContainerFormat::FLAC;
+        format = AudioStreamContainerFormat::MP3;
+        return true;
+    }
+    return false;
+}
+
+static void closeStream(void* stream)
+{
+    delete (CompressedInputSource*)stream;
+}
+
+static int ReadCompressedBinaryData(void *stream, uint8_t *ptr, uint32_t bufSize)
+{
+    return ((CompressedInputSource*)stream)->Read(ptr, bufSize);
+}
+
+// Recognizes one compressed file on the shared config; returns true when the
+// clip was processed (recognized speech or a clean no-match), false on input
+// or service errors. Output lines carry the file name so interleaved worker
+// output stays readable.
+bool recognizeSpeech(const std::shared_ptr<SpeechConfig>& config, const std::string& compressedFileName)
+{
+    std::shared_ptr<SpeechRecognizer> recognizer;
+    std::shared_ptr<PullAudioInputStream> pullAudioStream;
+
+    AudioStreamContainerFormat inputFormat;
+
+    // First choice: map the file and sniff the container from its leading
+    // magic bytes. That lifts the filename-extension requirement and serves
+    // the read callback straight from the mapping. Owned by the pull stream
+    // once created; the close callback deletes it.
+    CompressedInputSource* inputSource = NULL;
+    MemoryMappedCompressedFile* mappedFile = new MemoryMappedCompressedFile(compressedFileName);
+    if (mappedFile->IsOpen() && DetectContainerFormat(mappedFile->Data(), mappedFile->Size(), inputFormat))
+    {
+        inputSource = mappedFile;
     }
     else
     {
-        std::cout << "Only Opus and MP3 input files are currently supported" << std::endl;
-        return;
+        delete mappedFile;
+
+        // Headerless raw formats (and input that cannot be mapped) fall back
+        // to extension-based selection over the prefetching reader.
+        if (compressedFileName.find(".mp3") == (compressedFileName.size() - 4))
+        {
+            inputFormat = AudioStreamContainerFormat::MP3;
+        }
+        else if (compressedFileName.find(".opus") == (compressedFileName.size() - 5))
+        {
+            inputFormat = AudioStreamContainerFormat::OGG_OPUS;
+        }
+        else if (compressedFileName.find(".alaw") == (compressedFileName.size() - 5))
+        {
+            inputFormat = AudioStreamContainerFormat::ALAW;
+        }
+        else if (compressedFileName.find(".mulaw") == (compressedFileName.size() - 6))
+        {
+            inputFormat = AudioStreamContainerFormat::MULAW;
+        }
+        else if (compressedFileName.find(".flac") == (compressedFileName.size() - 5))
+        {
+            inputFormat = AudioStreamContainerFormat::FLAC;
+        }
+        else
+        {
+            std::cout << compressedFileName << ": Unable to detect the input container from the file header or extension" << std::endl;
+            return false;
+        }
+
+        CompressedFilePrefetcher* prefetcher = new CompressedFilePrefetcher(compressedFileName);
+        if (!prefetcher->IsOpen())
+        {
+            delete prefetcher;
+            std::cout << compressedFileName << ": Error: Input file doesn't exist" << std::endl;
+            return false;
+        }
+        inputSource = prefetcher;
     }
 
     pullAudioStream = AudioInputStream::CreatePullStream(
         AudioStreamFormat::GetCompressedFormat(inputFormat),
-        compressedFilePtr,
+        inputSource,
         ReadCompressedBinaryData,
         closeStream
     );
     recognizer = SpeechRecognizer::FromConfig(config, AudioConfig::FromStreamInput(pullAudioStream));
 
-    std::cout << "Recognizing ..." << std::endl;
+    std::cout << compressedFileName << ": Recognizing ..." << std::endl;
 
     // Starts speech recognition, and returns after a single utterance is recognized. The end of a
     // single utterance is determined by listening for silence at the end or until a maximum of 15
@@ -102,14 +339,16 @@ void recognizeSpeech(const std::string& compressedFileName)
 
     // Checks result.
     if (result->Reason == ResultReason::RecognizedSpeech) {
-        std::cout << "We recognized: " << result->Text << std::endl;
+        std::cout << compressedFileName << ": We recognized: " << result->Text << std::endl;
+        return true;
     }
     else if (result->Reason == ResultReason::NoMatch) {
-        std::cout << "NOMATCH: Speech could not be recognized." << std::endl;
+        std::cout << compressedFileName << ": NOMATCH: Speech could not be recognized." << std::endl;
+        return true;
     }
     else if (result->Reason == ResultReason::Canceled) {
         auto cancellation = CancellationDetails::FromResult(result);
-        std::cout << "CANCELED: Reason=" << (int)cancellation->Reason << std::endl;
+        std::cout << compressedFileName << ": CANCELED: Reason=" << (int)cancellation->Reason << std::endl;
 
         if (cancellation->Reason == CancellationReason::Error) {
             std::cout << "CANCELED: ErrorCode= " << (int)cancellation->ErrorCode << std::endl;
@@ -117,15 +356,116 @@ void recognizeSpeech(const std::string& compressedFileName)
             std::cout << "CANCELED: Did you update the subscription info?" << std::endl;
         }
     }
+    return false;
+}
+
+// Expands an argument into input files: a directory contributes its regular
+// files (non-recursive), anything else is taken as a file path.
+static void collectInputFiles(const std::string& path, std::vector<std::string>& files)
+{
+    struct stat pathInfo;
+    if (stat(path.c_str(), &pathInfo) == 0 && S_ISDIR(pathInfo.st_mode))
+    {
+        DIR* dir = opendir(path.c_str());
+        if (dir == NULL)
+        {
+            return;
+        }
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL)
+        {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..")
+            {
+                continue;
+            }
+            std::string fullPath = path + "/" + name;
+            struct stat entryInfo;
+            if (stat(fullPath.c_str(), &entryInfo) == 0 && S_ISREG(entryInfo.st_mode))
+            {
+                files.push_back(fullPath);
+            }
+        }
+        closedir(dir);
+    }
+    else
+    {
+        files.push_back(path);
+    }
 }
 
 int main(int argc, char **argv) {
-    if (argc != 2)
+    std::vector<std::string> files;
+    size_t concurrency = 4;
+
+    for (int i = 1; i < argc; i++)
     {
-        std::cout << "Usage: ./compressed-audio-input <filename>" << std::endl;
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc)
+        {
+            concurrency = (size_t)atoi(argv[++i]);
+            continue;
+        }
+        collectInputFiles(arg, files);
+    }
+
+    if (files.empty() || concurrency == 0)
+    {
+        std::cout << "Usage: ./compressed-audio-input [-j concurrency] <file|directory> ..." << std::endl;
         return 0;
     }
     setlocale(LC_ALL, "");
-    recognizeSpeech(argv[1]);
+
+    // One speech config shared by every session; each in-flight file gets its
+    // own pull stream and recognizer.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    if (files.size() == 1)
+    {
+        recognizeSpeech(config, files[0]);
+        return 0;
+    }
+
+    if (concurrency > files.size())
+    {
+        concurrency = files.size();
+    }
+
+    // Bounded session pool: workers pull the next file from a shared index,
+    // so at most 'concurrency' recognizer stacks exist at a time however many
+    // clips are queued.
+    std::atomic<size_t> nextFile(0);
+    std::atomic<size_t> processed(0);
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 0; worker < concurrency; worker++)
+    {
+        workers.emplace_back([&files, &nextFile, &processed, &config]()
+        {
+            for (;;)
+            {
+                size_t index = nextFile.fetch_add(1);
+                if (index >= files.size())
+                {
+                    break;
+                }
+                if (recognizeSpeech(config, files[index]))
+                {
+                    processed++;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "Processed " << processed << " of " << files.size() << " clips in "
+              << elapsedSeconds << " s (" << (elapsedSeconds > 0 ? files.size() / elapsedSeconds : 0)
+              << " clips/sec, " << concurrency << " concurrent sessions)" << std::endl;
     return 0;
 }
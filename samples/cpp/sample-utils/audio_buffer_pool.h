@@ -0,0 +1,108 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// A small pool of fixed-size audio feed buffers shared by the push/pull feed loops.
+// Each loop leases a buffer for the duration of a session and the storage goes back
+// to the pool when the lease is destroyed, so steady-state feeding does not allocate:
+// thousands of short sessions reuse the same few buffers instead of churning the heap.
+class AudioBufferPool final
+{
+public:
+
+    // A leased buffer. Move-only; returns its storage to the pool on destruction.
+    class Lease final
+    {
+    public:
+        Lease(AudioBufferPool* pool, std::vector<uint8_t>&& storage)
+            : m_pool(pool), m_storage(std::move(storage))
+        {
+        }
+
+        ~Lease()
+        {
+            if (m_pool != nullptr)
+            {
+                m_pool->Return(std::move(m_storage));
+            }
+        }
+
+        Lease(Lease&& other) noexcept
+            : m_pool(other.m_pool), m_storage(std::move(other.m_storage))
+        {
+            other.m_pool = nullptr;
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+
+        uint8_t* Data()
+        {
+            return m_storage.data();
+        }
+
+        size_t Size() const
+        {
+            return m_storage.size();
+        }
+
+    private:
+        AudioBufferPool* m_pool;
+        std::vector<uint8_t> m_storage;
+    };
+
+    // 'bufferSize' is the size of every pooled buffer (the default is 100 ms of
+    // 16 kHz mono int16 audio); at most 'maxPooledBuffers' idle buffers are kept.
+    explicit AudioBufferPool(size_t bufferSize = 3200, size_t maxPooledBuffers = 16)
+        : m_bufferSize(bufferSize), m_maxPooledBuffers(maxPooledBuffers)
+    {
+    }
+
+    AudioBufferPool(const AudioBufferPool&) = delete;
+    AudioBufferPool& operator=(const AudioBufferPool&) = delete;
+
+    // Leases a buffer, recycling an idle one when available.
+    Lease Acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_freeBuffers.empty())
+            {
+                std::vector<uint8_t> storage = std::move(m_freeBuffers.back());
+                m_freeBuffers.pop_back();
+                return Lease(this, std::move(storage));
+            }
+        }
+        return Lease(this, std::vector<uint8_t>(m_bufferSize));
+    }
+
+    // The process-wide pool shared by the sample feed loops.
+    static AudioBufferPool& Shared()
+    {
+        static AudioBufferPool pool;
+        return pool;
+    }
+
+private:
+    void Return(std::vector<uint8_t>&& storage)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (storage.size() == m_bufferSize && m_freeBuffers.size() < m_maxPooledBuffers)
+        {
+            m_freeBuffers.push_back(std::move(storage));
+        }
+    }
+
+private:
+    size_t m_bufferSize;
+    size_t m_maxPooledBuffers;
+    std::mutex m_mutex;
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+};
@@ -0,0 +1,99 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// Translation unit of the speech-sample-utils static library. The hot audio
+// kernels — the per-format sample converters and the stereo downmix — are
+// defined here rather than in the headers, so one build of the library serves
+// every sample and quickstart that links it, and the kernels always get the
+// library's optimization flags even when the linking binary is a debug build.
+
+#include "wav_file_reader.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__) || defined(__x86_64__)
+#define WAV_FILE_READER_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define WAV_FILE_READER_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+void ConvertSamples<16, 1>::Convert(const uint8_t* src, int16_t* dst, size_t frames)
+{
+    // Already the target format, a single block copy.
+    memcpy(dst, src, frames * sizeof(int16_t));
+}
+
+void ConvertSamples<24, 1>::Convert(const uint8_t* src, int16_t* dst, size_t frames)
+{
+    for (size_t i = 0; i < frames; ++i, src += 3)
+    {
+        // Keeps the 16 most significant bits of the 24-bit sample.
+        dst[i] = (int16_t)((uint16_t)src[1] | ((uint16_t)src[2] << 8));
+    }
+}
+
+void ConvertSamples<32, 1>::Convert(const uint8_t* src, int16_t* dst, size_t frames)
+{
+    for (size_t i = 0; i < frames; ++i, src += 4)
+    {
+        float sample;
+        memcpy(&sample, src, sizeof(sample));
+        float scaled = sample * 32767.0f;
+        scaled = scaled > 32767.0f ? 32767.0f : (scaled < -32768.0f ? -32768.0f : scaled);
+        dst[i] = (int16_t)scaled;
+    }
+}
+
+void ConvertSamples<24, 2>::Convert(const uint8_t* src, int16_t* dst, size_t frames)
+{
+    for (size_t i = 0; i < frames; ++i, src += 6)
+    {
+        int32_t left = (int16_t)((uint16_t)src[1] | ((uint16_t)src[2] << 8));
+        int32_t right = (int16_t)((uint16_t)src[4] | ((uint16_t)src[5] << 8));
+        dst[i] = (int16_t)((left + right) >> 1);
+    }
+}
+
+void ConvertSamples<32, 2>::Convert(const uint8_t* src, int16_t* dst, size_t frames)
+{
+    for (size_t i = 0; i < frames; ++i, src += 8)
+    {
+        float left, right;
+        memcpy(&left, src, sizeof(left));
+        memcpy(&right, src + 4, sizeof(right));
+        float scaled = (left + right) * 0.5f * 32767.0f;
+        scaled = scaled > 32767.0f ? 32767.0f : (scaled < -32768.0f ? -32768.0f : scaled);
+        dst[i] = (int16_t)scaled;
+    }
+}
+
+void WavFileReader::DownmixStereoToMono(const int16_t* stereo, int16_t* mono, size_t frames)
+{
+    size_t i = 0;
+
+#if defined(WAV_FILE_READER_USE_SSE2)
+    // _mm_madd_epi16 with unit coefficients sums each L/R pair into 32 bits,
+    // which avoids overflow before the halving shift.
+    const __m128i ones = _mm_set1_epi16(1);
+    for (; i + 8 <= frames; i += 8)
+    {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(stereo + 2 * i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(stereo + 2 * i + 8));
+        __m128i sumLo = _mm_srai_epi32(_mm_madd_epi16(lo, ones), 1);
+        __m128i sumHi = _mm_srai_epi32(_mm_madd_epi16(hi, ones), 1);
+        _mm_storeu_si128((__m128i*)(mono + i), _mm_packs_epi32(sumLo, sumHi));
+    }
+#elif defined(WAV_FILE_READER_USE_NEON)
+    for (; i + 8 <= frames; i += 8)
+    {
+        int16x8x2_t channels = vld2q_s16(stereo + 2 * i);
+        vst1q_s16(mono + i, vhaddq_s16(channels.val[0], channels.val[1]));
+    }
+#endif
+
+    for (; i < frames; ++i)
+    {
+        mono[i] = (int16_t)(((int32_t)stereo[2 * i] + stereo[2 * i + 1]) >> 1);
+    }
+}
@@ -0,0 +1,113 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// A lock-free single-producer/single-consumer byte ring buffer. One thread may call
+// Write() and another may call Read() concurrently without any mutex, so a capture
+// (or file read) thread can hand audio to the thread calling
+// PushAudioInputStream::Write() without adding lock jitter to either side.
+class SpscRingBuffer final
+{
+public:
+
+    // 'capacity' is rounded up to the next power of two so index wrapping is a mask.
+    explicit SpscRingBuffer(size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("Ring buffer capacity must not be zero.");
+        }
+
+        size_t rounded = 1;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        m_storage.resize(rounded);
+        m_mask = rounded - 1;
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Producer side: copies up to 'size' bytes into the ring.
+    // Returns the number of bytes accepted (0 when the ring is full).
+    size_t Write(const uint8_t* data, size_t size)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+
+        size_t free = m_storage.size() - (head - tail);
+        size_t toCopy = size < free ? size : free;
+        if (toCopy == 0)
+        {
+            return 0;
+        }
+
+        size_t index = head & m_mask;
+        size_t firstPart = m_storage.size() - index;
+        if (firstPart > toCopy)
+        {
+            firstPart = toCopy;
+        }
+        memcpy(m_storage.data() + index, data, firstPart);
+        memcpy(m_storage.data(), data + firstPart, toCopy - firstPart);
+
+        m_head.store(head + toCopy, std::memory_order_release);
+        return toCopy;
+    }
+
+    // Consumer side: copies up to 'size' bytes out of the ring, coalescing whatever
+    // the producer has published so far into one contiguous destination buffer.
+    // Returns the number of bytes copied (0 when the ring is empty).
+    size_t Read(uint8_t* data, size_t size)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+
+        size_t available = head - tail;
+        size_t toCopy = size < available ? size : available;
+        if (toCopy == 0)
+        {
+            return 0;
+        }
+
+        size_t index = tail & m_mask;
+        size_t firstPart = m_storage.size() - index;
+        if (firstPart > toCopy)
+        {
+            firstPart = toCopy;
+        }
+        memcpy(data, m_storage.data() + index, firstPart);
+        memcpy(data + firstPart, m_storage.data(), toCopy - firstPart);
+
+        m_tail.store(tail + toCopy, std::memory_order_release);
+        return toCopy;
+    }
+
+    // Usable capacity in bytes (the requested capacity rounded up).
+    size_t Capacity() const
+    {
+        return m_storage.size();
+    }
+
+    // Approximate fill level; exact only from the calling side's perspective.
+    size_t ApproximateSize() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<uint8_t> m_storage;
+    size_t m_mask = 0;
+    std::atomic<size_t> m_head{ 0 };
+    std::atomic<size_t> m_tail{ 0 };
+};
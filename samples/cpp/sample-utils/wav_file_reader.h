@@ -0,0 +1,379 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Converts a block of source frames into mono int16 samples. Bit depth and channel
+// count are compile-time parameters, so each instantiation is a straight branch-free
+// kernel: the converter matching a file is selected once from its parsed fmt chunk,
+// and the per-sample loop contains no format dispatch at all.
+// 24-bit samples are little-endian signed integers; 32-bit samples are IEEE floats.
+// The kernel bodies are compiled into the speech-sample-utils library, so they are
+// built with the library's optimization flags regardless of how the sample binary
+// that links them is configured.
+template <uint16_t BitsPerSample, uint16_t Channels>
+struct ConvertSamples;
+
+template <>
+struct ConvertSamples<16, 1>
+{
+    static constexpr size_t sourceFrameSize = 2;
+    static void Convert(const uint8_t* src, int16_t* dst, size_t frames);
+};
+
+template <>
+struct ConvertSamples<24, 1>
+{
+    static constexpr size_t sourceFrameSize = 3;
+    static void Convert(const uint8_t* src, int16_t* dst, size_t frames);
+};
+
+template <>
+struct ConvertSamples<32, 1>
+{
+    static constexpr size_t sourceFrameSize = 4;
+    static void Convert(const uint8_t* src, int16_t* dst, size_t frames);
+};
+
+template <>
+struct ConvertSamples<24, 2>
+{
+    static constexpr size_t sourceFrameSize = 6;
+    static void Convert(const uint8_t* src, int16_t* dst, size_t frames);
+};
+
+template <>
+struct ConvertSamples<32, 2>
+{
+    static constexpr size_t sourceFrameSize = 8;
+    static void Convert(const uint8_t* src, int16_t* dst, size_t frames);
+};
+
+// Helper functions
+class WavFileReader final
+{
+public:
+
+    // Constructor that creates an input stream from a file.
+    // A non-zero 'readAheadSize' turns on sequential-read mode: the file is opened
+    // with a stream buffer of that size, so however small the Read() calls from the
+    // SDK are, the kernel only sees block-sized reads, and on POSIX the kernel is
+    // additionally hinted that the file will be scanned sequentially.
+    WavFileReader(const std::string& audioFileName, size_t readAheadSize = 0)
+    {
+        if (audioFileName.empty())
+        {
+            throw std::invalid_argument("Audio filename is empty");
+        }
+
+        if (readAheadSize > 0)
+        {
+            // The buffer must be installed before open() for it to take effect.
+            m_readAheadStorage.resize(readAheadSize);
+            m_fs.rdbuf()->pubsetbuf((char*)m_readAheadStorage.data(), readAheadSize);
+            HintSequentialRead(audioFileName);
+        }
+
+        std::ios_base::openmode mode = std::ios_base::binary | std::ios_base::in;
+        m_fs.open(audioFileName, mode);
+        if (!m_fs.good())
+        {
+            throw std::invalid_argument("Failed to open the specified audio file.");
+        }
+
+        // Get audio format from the file header.
+        GetFormatFromWavFile();
+
+        // Pick the PCM conversion kernel matching the parsed format, once per file.
+        SelectConverter();
+    }
+
+    int Read(uint8_t* dataBuffer, uint32_t size)
+    {
+        // Stereo int16 input is downmixed to mono in line, so stereo recordings can be
+        // recognized directly without an offline preconversion pass.
+        if (m_formatHeader.Channels == 2 && m_formatHeader.BitsPerSample == 16)
+        {
+            return ReadWithStereoDownmix(dataBuffer, size);
+        }
+
+        // 24-bit and 32-bit-float input goes through the format-specialized
+        // conversion kernel selected from the header; 16-bit mono is read directly.
+        if (m_convert != nullptr)
+        {
+            return ReadWithConversion(dataBuffer, size);
+        }
+
+        if (m_fs.eof())
+            // returns 0 to indicate that the stream reaches end.
+            return 0;
+        m_fs.read((char*)dataBuffer, size);
+        if (!m_fs.eof() && !m_fs.good())
+            // returns 0 to close the stream on read error.
+            return 0;
+        else
+            // returns the number of bytes that have been read.
+            return (int)m_fs.gcount();
+    }
+
+    void Close()
+    {
+        m_fs.close();
+    }
+
+    // Gets the sample rate parsed from the fmt chunk.
+    uint32_t GetSamplesPerSec() const
+    {
+        return m_formatHeader.SamplesPerSec;
+    }
+
+    // Gets the number of channels of the audio data produced by Read().
+    // Every stereo path downmixes in line -- 16-bit stereo through the vectorized
+    // downmix and 24-bit/32-bit-float stereo inside the conversion kernel -- so
+    // stereo input with a collapsing path selected is reported as mono.
+    uint16_t GetChannels() const
+    {
+        if (m_formatHeader.Channels == 2 && (m_formatHeader.BitsPerSample == 16 || m_convert != nullptr))
+        {
+            return 1;
+        }
+        return m_formatHeader.Channels;
+    }
+
+    // Gets the number of bits per sample of the audio data produced by Read().
+    // The conversion kernels emit int16, so 24-bit and 32-bit-float input is
+    // reported as 16; otherwise this is the depth parsed from the fmt chunk.
+    uint16_t GetBitsPerSample() const
+    {
+        return m_convert != nullptr ? 16 : m_formatHeader.BitsPerSample;
+    }
+
+private:
+    // Defines common constants for WAV format.
+    static constexpr uint16_t tagBufferSize = 4;
+    static constexpr uint16_t chunkTypeBufferSize = 4;
+    static constexpr uint16_t chunkSizeBufferSize = 4;
+
+    // Get format data from a wav file.
+    void GetFormatFromWavFile()
+    {
+        char tag[tagBufferSize];
+        char chunkType[chunkTypeBufferSize];
+        char chunkSizeBuffer[chunkSizeBufferSize];
+        uint32_t chunkSize = 0;
+
+        // Set to throw exceptions when reading file header.
+        m_fs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+        try
+        {
+            // Checks the RIFF tag
+            m_fs.read(tag, tagBufferSize);
+            if (memcmp(tag, "RIFF", tagBufferSize) != 0)
+            {
+                throw std::runtime_error("Invalid file header, tag 'RIFF' is expected.");
+            }
+
+            // The next is the RIFF chunk size, ignore now.
+            m_fs.read(chunkSizeBuffer, chunkSizeBufferSize);
+
+            // Checks the 'WAVE' tag in the wave header.
+            m_fs.read(chunkType, chunkTypeBufferSize);
+            if (memcmp(chunkType, "WAVE", chunkTypeBufferSize) != 0)
+            {
+                throw std::runtime_error("Invalid file header, tag 'WAVE' is expected.");
+            }
+
+            bool foundDataChunk = false;
+            while (!foundDataChunk && m_fs.good() && !m_fs.eof())
+            {
+                ReadChunkTypeAndSize(chunkType, &chunkSize);
+                if (memcmp(chunkType, "fmt ", chunkTypeBufferSize) == 0)
+                {
+                    // Reads format data.
+                    m_fs.read((char *)&m_formatHeader, sizeof(m_formatHeader));
+
+                    // Skips the rest of format data.
+                    if (chunkSize > sizeof(m_formatHeader))
+                    {
+                        m_fs.seekg(chunkSize - sizeof(m_formatHeader), std::ios_base::cur);
+                    }
+                }
+                else if (memcmp(chunkType, "data", chunkTypeBufferSize) == 0)
+                {
+                    foundDataChunk = true;
+                    break;
+                }
+                else
+                {
+                    m_fs.seekg(chunkSize, std::ios_base::cur);
+                }
+            }
+
+            if (!foundDataChunk)
+            {
+                throw std::runtime_error("Did not find data chunk.");
+            }
+            if (m_fs.eof() && chunkSize > 0)
+            {
+                throw std::runtime_error("Unexpected end of file, before any audio data can be read.");
+            }
+        }
+        catch (std::ifstream::failure e)
+        {
+            throw std::runtime_error("Unexpected end of file or error when reading audio file.");
+        }
+        // Set to not throw exceptions when starting to read audio data
+        m_fs.exceptions(std::ifstream::goodbit);
+    }
+
+    // Tells the kernel the file will be read sequentially and asks for readahead.
+    // On Windows the sequential-scan hint needs FILE_FLAG_SEQUENTIAL_SCAN at open,
+    // which MemoryMappedWavFileReader uses; the large stream buffer alone already
+    // collapses the syscall count here.
+    static void HintSequentialRead(const std::string& audioFileName)
+    {
+#if !defined(_WIN32)
+        int fd = open(audioFileName.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+#if defined(POSIX_FADV_SEQUENTIAL)
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+            close(fd);
+        }
+#else
+        (void)audioFileName;
+#endif
+    }
+
+    // Binds the converter and source frame size of one ConvertSamples instantiation.
+    template <uint16_t BitsPerSample, uint16_t Channels>
+    void UseConverter()
+    {
+        m_convert = &ConvertSamples<BitsPerSample, Channels>::Convert;
+        m_sourceFrameSize = ConvertSamples<BitsPerSample, Channels>::sourceFrameSize;
+    }
+
+    // Selects the conversion kernel for the parsed format. 16-bit mono needs none,
+    // and 16-bit stereo goes through the vectorized downmix path instead.
+    void SelectConverter()
+    {
+        const uint16_t pcmTag = 1;       // WAVE_FORMAT_PCM
+        const uint16_t ieeeFloatTag = 3; // WAVE_FORMAT_IEEE_FLOAT
+
+        if (m_formatHeader.FormatTag == pcmTag && m_formatHeader.BitsPerSample == 24)
+        {
+            m_formatHeader.Channels == 2 ? UseConverter<24, 2>() : UseConverter<24, 1>();
+        }
+        else if (m_formatHeader.FormatTag == ieeeFloatTag && m_formatHeader.BitsPerSample == 32)
+        {
+            m_formatHeader.Channels == 2 ? UseConverter<32, 2>() : UseConverter<32, 1>();
+        }
+    }
+
+    // Reads whole source frames and runs them through the selected conversion kernel,
+    // returning the number of mono int16 bytes produced.
+    int ReadWithConversion(uint8_t* dataBuffer, uint32_t size)
+    {
+        if (m_fs.eof())
+        {
+            return 0;
+        }
+
+        size_t maxFrames = size / sizeof(int16_t);
+        m_conversionBuffer.resize(maxFrames * m_sourceFrameSize);
+        m_fs.read((char*)m_conversionBuffer.data(), m_conversionBuffer.size());
+        if (!m_fs.eof() && !m_fs.good())
+        {
+            return 0;
+        }
+
+        size_t frames = (size_t)m_fs.gcount() / m_sourceFrameSize;
+        m_convert(m_conversionBuffer.data(), (int16_t*)dataBuffer, frames);
+        return (int)(frames * sizeof(int16_t));
+    }
+
+    // Reads twice the requested amount of stereo data and averages each interleaved
+    // frame down to one mono sample, returning the number of mono bytes produced.
+    int ReadWithStereoDownmix(uint8_t* dataBuffer, uint32_t size)
+    {
+        if (m_fs.eof())
+        {
+            return 0;
+        }
+
+        // Two stereo bytes produce one mono byte; read whole frames only.
+        uint32_t stereoBytes = (size & ~1u) * 2;
+        m_stereoBuffer.resize(stereoBytes);
+        m_fs.read((char*)m_stereoBuffer.data(), stereoBytes);
+        if (!m_fs.eof() && !m_fs.good())
+        {
+            return 0;
+        }
+
+        size_t frames = (size_t)m_fs.gcount() / (2 * sizeof(int16_t));
+        DownmixStereoToMono((const int16_t*)m_stereoBuffer.data(), (int16_t*)dataBuffer, frames);
+        return (int)(frames * sizeof(int16_t));
+    }
+
+    // Averages interleaved stereo int16 frames into mono samples, vectorized where
+    // available. Compiled into the speech-sample-utils library.
+    static void DownmixStereoToMono(const int16_t* stereo, int16_t* mono, size_t frames);
+
+    void ReadChunkTypeAndSize(char* chunkType, uint32_t* chunkSize)
+    {
+        // Read the chunk type
+        m_fs.read(chunkType, chunkTypeBufferSize);
+
+        // Read the chunk size
+        uint8_t chunkSizeBuffer[chunkSizeBufferSize];
+        m_fs.read((char*)chunkSizeBuffer, chunkSizeBufferSize);
+
+        // chunk size is little endian
+        *chunkSize = ((uint32_t)chunkSizeBuffer[3] << 24) |
+            ((uint32_t)chunkSizeBuffer[2] << 16) |
+            ((uint32_t)chunkSizeBuffer[1] << 8) |
+            (uint32_t)chunkSizeBuffer[0];
+    }
+
+    // The format structure expected in wav files.
+    struct WAVEFORMAT
+    {
+        uint16_t FormatTag;        // format type.
+        uint16_t Channels;         // number of channels (i.e. mono, stereo...).
+        uint32_t SamplesPerSec;    // sample rate.
+        uint32_t AvgBytesPerSec;   // for buffer estimation.
+        uint16_t BlockAlign;       // block size of data.
+        uint16_t BitsPerSample;    // Number of bits per sample of mono data.
+    } m_formatHeader;
+    static_assert(sizeof(m_formatHeader) == 16, "unexpected size of m_formatHeader");
+
+private:
+    std::fstream m_fs;
+
+    // Scratch space for stereo frames before they are downmixed to mono.
+    std::vector<uint8_t> m_stereoBuffer;
+
+    // Conversion kernel selected once per file, and its scratch space.
+    void (*m_convert)(const uint8_t*, int16_t*, size_t) = nullptr;
+    size_t m_sourceFrameSize = 0;
+    std::vector<uint8_t> m_conversionBuffer;
+
+    // Backing storage for the large stream buffer in sequential-read mode.
+    std::vector<uint8_t> m_readAheadStorage;
+};
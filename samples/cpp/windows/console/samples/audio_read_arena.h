@@ -0,0 +1,61 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <speechapi_cxx.h>
+
+// Arena-backed reader for synthesis audio data streams. Draining a stream into
+// freshly allocated buffers per iteration churns the allocator on every chunk;
+// the arena instead makes one allocation sized from the caller's hint (e.g.
+// result->GetAudioLength()), fills it with large ReadData calls, and keeps the
+// storage across requests. It only grows — geometrically, when a hint proves
+// low — so steady-state reads allocate nothing.
+class AudioReadArena final
+{
+public:
+
+    // Drains 'stream' into the arena and returns a pointer to the audio along
+    // with its size. The pointer stays valid until the next ReadAll call.
+    const uint8_t* ReadAll(std::shared_ptr<Microsoft::CognitiveServices::Speech::AudioDataStream> stream,
+        size_t sizeHint, size_t* size)
+    {
+        if (m_storage.size() < sizeHint)
+        {
+            m_storage.resize(sizeHint);
+        }
+        if (m_storage.size() < minimumSize)
+        {
+            m_storage.resize(minimumSize);
+        }
+
+        size_t used = 0;
+        for (;;)
+        {
+            if (used == m_storage.size())
+            {
+                // The hint was low; grow geometrically so total copying stays linear.
+                m_storage.resize(m_storage.size() + m_storage.size() / 2);
+            }
+
+            uint32_t filled = stream->ReadData(m_storage.data() + used, (uint32_t)(m_storage.size() - used));
+            if (filled == 0)
+            {
+                break;
+            }
+            used += filled;
+        }
+
+        *size = used;
+        return m_storage.data();
+    }
+
+private:
+    static constexpr size_t minimumSize = 64 * 1024;
+
+    std::vector<uint8_t> m_storage;
+};
@@ -0,0 +1,230 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#include "stdafx.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "wav_file_reader.h"
+#include "audio_buffer_pool.h"
+#include "chunked_audio_accumulator.h"
+#include "latency_recorder.h"
+#include "spsc_ring_buffer.h"
+#include "voice_activity_gate.h"
+
+using namespace std;
+
+// Offline benchmarks for the local feed-path hot spots: WAV file reading,
+// push-stream feeding (reader + voice activity gate + ring buffer, with a
+// loopback consumer standing in for the SDK), and synthesis audio
+// accumulation. Everything runs against generated input, so the suite needs
+// no service connection and its numbers isolate client-side overhead.
+// Each benchmark prints one JSON line so regressions can be tracked by
+// machines, not eyeballs.
+
+namespace
+{
+    // 16 kHz mono 16-bit PCM at this byte rate; used to convert processed
+    // bytes into audio seconds for the real-time factor.
+    constexpr uint32_t benchmarkBytesPerSec = 32000;
+
+    // Writes a WAV file of the given length filled with a 440 Hz tone, loud
+    // enough that the voice activity gate treats it as speech.
+    void WriteBenchmarkInput(const string& fileName, int seconds)
+    {
+        uint32_t dataBytes = benchmarkBytesPerSec * seconds;
+        ofstream file(fileName, ios::binary | ios::trunc);
+
+        auto write32 = [&file](uint32_t v) { file.write(reinterpret_cast<const char*>(&v), 4); };
+        auto write16 = [&file](uint16_t v) { file.write(reinterpret_cast<const char*>(&v), 2); };
+        file.write("RIFF", 4);
+        write32(36 + dataBytes);
+        file.write("WAVE", 4);
+        file.write("fmt ", 4);
+        write32(16);
+        write16(1);               // PCM
+        write16(1);               // mono
+        write32(16000);           // samples per second
+        write32(benchmarkBytesPerSec);
+        write16(2);               // block align
+        write16(16);              // bits per sample
+        file.write("data", 4);
+        write32(dataBytes);
+
+        vector<int16_t> tone(16000);
+        for (size_t i = 0; i < tone.size(); i++)
+        {
+            tone[i] = (int16_t)(8000 * sin(2.0 * 3.14159265358979 * 440.0 * i / 16000.0));
+        }
+        for (int second = 0; second < seconds; second++)
+        {
+            file.write(reinterpret_cast<const char*>(tone.data()), tone.size() * sizeof(int16_t));
+        }
+    }
+
+    // Prints one machine-readable result line. Latencies are per-chunk
+    // operation times in microseconds; 'values' is consumed (sorted).
+    void Report(const char* name, uint64_t bytes, double elapsedSeconds, vector<double> values)
+    {
+        sort(values.begin(), values.end());
+        cout << "{\"benchmark\":\"" << name << "\""
+            << ",\"bytes\":" << bytes
+            << ",\"bytes_per_sec\":" << (uint64_t)(bytes / elapsedSeconds)
+            << ",\"rtf\":" << (bytes / (double)benchmarkBytesPerSec) / elapsedSeconds
+            << ",\"p50_us\":" << LatencyRecorder::Percentile(values, 50)
+            << ",\"p95_us\":" << LatencyRecorder::Percentile(values, 95)
+            << ",\"p99_us\":" << LatencyRecorder::Percentile(values, 99)
+            << "}" << endl;
+    }
+
+    // WavFileReader::Read in sequential-read mode, the pattern every
+    // file-fed sample starts from.
+    void BenchmarkWavRead(const string& inputFileName)
+    {
+        WavFileReader reader(inputFileName, 1024 * 1024);
+        auto buffer = AudioBufferPool::Shared().Acquire();
+
+        vector<double> chunkMicros;
+        uint64_t totalBytes = 0;
+        auto start = chrono::steady_clock::now();
+
+        int readBytes;
+        while (true)
+        {
+            auto chunkStart = chrono::steady_clock::now();
+            readBytes = reader.Read(buffer.Data(), (uint32_t)buffer.Size());
+            if (readBytes == 0)
+            {
+                break;
+            }
+            chunkMicros.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - chunkStart).count());
+            totalBytes += readBytes;
+        }
+
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        Report("wav-read", totalBytes, elapsed, move(chunkMicros));
+    }
+
+    // The push-stream feed path with a loopback consumer in place of
+    // PushAudioInputStream::Write: read, gate, hand off through the ring.
+    void BenchmarkPushStreamFeed(const string& inputFileName)
+    {
+        WavFileReader reader(inputFileName, 1024 * 1024);
+        auto buffer = AudioBufferPool::Shared().Acquire();
+        VoiceActivityGate vadGate;
+        SpscRingBuffer ring(256 * 1024);
+
+        atomic<bool> producerDone{ false };
+        atomic<uint64_t> consumedBytes{ 0 };
+        thread consumer([&]()
+        {
+            vector<uint8_t> sink(64 * 1024);
+            while (true)
+            {
+                size_t bytes = ring.Read(sink.data(), sink.size());
+                if (bytes > 0)
+                {
+                    consumedBytes.fetch_add(bytes, memory_order_relaxed);
+                }
+                else if (producerDone.load(memory_order_acquire))
+                {
+                    return;
+                }
+            }
+        });
+
+        vector<double> chunkMicros;
+        uint64_t totalBytes = 0;
+        auto start = chrono::steady_clock::now();
+
+        int readBytes;
+        while (true)
+        {
+            auto chunkStart = chrono::steady_clock::now();
+            readBytes = reader.Read(buffer.Data(), (uint32_t)buffer.Size());
+            if (readBytes == 0)
+            {
+                break;
+            }
+            if (vadGate.Accept(buffer.Data(), (size_t)readBytes))
+            {
+                size_t written = 0;
+                while (written < (size_t)readBytes)
+                {
+                    written += ring.Write(buffer.Data() + written, readBytes - written);
+                }
+                totalBytes += readBytes;
+            }
+            chunkMicros.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - chunkStart).count());
+        }
+
+        producerDone.store(true, memory_order_release);
+        consumer.join();
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        if (consumedBytes.load() != totalBytes)
+        {
+            cout << "{\"benchmark\":\"push-stream-feed\",\"error\":\"byte count mismatch\"}" << endl;
+            return;
+        }
+        Report("push-stream-feed", totalBytes, elapsed, move(chunkMicros));
+    }
+
+    // Synthesis audio accumulation as done by the push-output-stream
+    // callback's Write: append fixed-size chunks, then flatten once.
+    void BenchmarkSynthesisAccumulation()
+    {
+        constexpr size_t chunkBytes = 3200;
+        constexpr size_t totalBytes = chunkBytes * 20000; // 64 MB in whole chunks
+        vector<uint8_t> chunk(chunkBytes, 0x5A);
+
+        ChunkedAudioAccumulator accumulator;
+        vector<double> chunkMicros;
+        auto start = chrono::steady_clock::now();
+
+        for (size_t appended = 0; appended < totalBytes; appended += chunkBytes)
+        {
+            auto chunkStart = chrono::steady_clock::now();
+            accumulator.Append(chunk.data(), chunk.size());
+            chunkMicros.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - chunkStart).count());
+        }
+        auto flattened = accumulator.Flatten();
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        if (flattened->size() != totalBytes)
+        {
+            cout << "{\"benchmark\":\"synthesis-accumulation\",\"error\":\"size mismatch\"}" << endl;
+            return;
+        }
+        Report("synthesis-accumulation", totalBytes, elapsed, move(chunkMicros));
+    }
+}
+
+// Entry point for 'samples bench'; returns the process exit code.
+int RunBenchmarks()
+{
+    const string inputFileName = "benchmark_input.wav";
+    WriteBenchmarkInput(inputFileName, 60);
+
+    try
+    {
+        BenchmarkWavRead(inputFileName);
+        BenchmarkPushStreamFeed(inputFileName);
+        BenchmarkSynthesisAccumulation();
+    }
+    catch (const exception& e)
+    {
+        cout << "Benchmark failed: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
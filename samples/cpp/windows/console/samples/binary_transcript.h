@@ -0,0 +1,416 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Offset-indexed binary transcript format. Each record is a fixed-size header
+// (session id, Result->Offset(), Duration(), reason) followed by the UTF-8
+// text, appended to a memory-mapped data file; a sidecar '<file>.idx' holds
+// one fixed-size {offset, position} entry per record. Post-processing maps
+// both files and binary-searches the index by time offset instead of
+// re-parsing gigabytes of console text.
+
+// Fixed-size header preceding each record's UTF-8 text in the data file.
+#pragma pack(push, 1)
+struct BinaryTranscriptRecord
+{
+    uint64_t OffsetTicks;    // Result->Offset(), in 100 ns ticks.
+    uint64_t DurationTicks;  // Result->Duration(), in 100 ns ticks.
+    uint32_t Reason;         // ResultReason as an integer.
+    uint32_t TextBytes;      // Length of the UTF-8 text following this header.
+    char SessionId[40];      // Session id, NUL padded.
+};
+
+// One entry per record in the '<file>.idx' sidecar; entries are appended in
+// arrival order, so for a single audio stream they are sorted by offset and
+// directly binary-searchable.
+struct BinaryTranscriptIndexEntry
+{
+    uint64_t OffsetTicks;    // Copy of the record's OffsetTicks.
+    uint64_t RecordPosition; // Byte position of the record header in the data file.
+};
+#pragma pack(pop)
+
+static_assert(sizeof(BinaryTranscriptRecord) == 64, "unexpected size of BinaryTranscriptRecord");
+static_assert(sizeof(BinaryTranscriptIndexEntry) == 16, "unexpected size of BinaryTranscriptIndexEntry");
+
+// A growable append-only memory mapping: the backing file is extended in
+// large steps and remapped, appends are plain memcpys into the mapping, and
+// Close() trims the file to the bytes actually written.
+class MappedAppendFile final
+{
+public:
+
+    explicit MappedAppendFile(const std::string& fileName, size_t growthStep)
+        : m_growthStep(growthStep)
+    {
+#if defined(_WIN32)
+        m_fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_fileHandle == INVALID_HANDLE_VALUE)
+        {
+            throw std::invalid_argument("Cannot open transcript file '" + fileName + "' for writing.");
+        }
+#else
+        m_fileDescriptor = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_fileDescriptor < 0)
+        {
+            throw std::invalid_argument("Cannot open transcript file '" + fileName + "' for writing.");
+        }
+#endif
+        Grow(m_growthStep);
+    }
+
+    ~MappedAppendFile()
+    {
+        Close();
+    }
+
+    MappedAppendFile(const MappedAppendFile&) = delete;
+    MappedAppendFile& operator=(const MappedAppendFile&) = delete;
+
+    // Copies 'bytes' into the mapping, growing it first when needed, and
+    // returns the position the data was written at.
+    uint64_t Append(const void* data, size_t bytes)
+    {
+        if (m_used + bytes > m_capacity)
+        {
+            size_t needed = m_used + bytes - m_capacity;
+            Grow(needed > m_growthStep ? needed + m_growthStep : m_growthStep);
+        }
+
+        memcpy(m_mapping + m_used, data, bytes);
+        uint64_t position = m_used;
+        m_used += bytes;
+        return position;
+    }
+
+    // Gets the number of bytes appended so far.
+    uint64_t Size() const
+    {
+        return m_used;
+    }
+
+    // Unmaps and trims the backing file to the appended length.
+    void Close()
+    {
+#if defined(_WIN32)
+        if (m_mapping != nullptr)
+        {
+            UnmapViewOfFile(m_mapping);
+            CloseHandle(m_mappingHandle);
+            m_mapping = nullptr;
+            m_mappingHandle = nullptr;
+        }
+        if (m_fileHandle != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER length;
+            length.QuadPart = (LONGLONG)m_used;
+            SetFilePointerEx(m_fileHandle, length, nullptr, FILE_BEGIN);
+            SetEndOfFile(m_fileHandle);
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_mapping != nullptr)
+        {
+            munmap(m_mapping, m_capacity);
+            m_mapping = nullptr;
+        }
+        if (m_fileDescriptor >= 0)
+        {
+            if (ftruncate(m_fileDescriptor, (off_t)m_used) != 0)
+            {
+                // The data is intact; the file merely keeps its growth padding.
+            }
+            close(m_fileDescriptor);
+            m_fileDescriptor = -1;
+        }
+#endif
+    }
+
+private:
+    // Extends the backing file by at least 'bytes' and remaps it whole.
+    void Grow(size_t bytes)
+    {
+        size_t newCapacity = m_capacity + bytes;
+#if defined(_WIN32)
+        if (m_mapping != nullptr)
+        {
+            UnmapViewOfFile(m_mapping);
+            CloseHandle(m_mappingHandle);
+        }
+
+        // CreateFileMapping with a larger size extends the file itself.
+        m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READWRITE,
+            (DWORD)((uint64_t)newCapacity >> 32), (DWORD)(newCapacity & 0xFFFFFFFFu), nullptr);
+        if (m_mappingHandle == nullptr)
+        {
+            throw std::runtime_error("Failed to grow the transcript file mapping.");
+        }
+
+        m_mapping = (uint8_t*)MapViewOfFile(m_mappingHandle, FILE_MAP_WRITE, 0, 0, 0);
+        if (m_mapping == nullptr)
+        {
+            throw std::runtime_error("Failed to map the transcript file.");
+        }
+#else
+        if (m_mapping != nullptr)
+        {
+            munmap(m_mapping, m_capacity);
+            m_mapping = nullptr;
+        }
+
+        if (ftruncate(m_fileDescriptor, (off_t)newCapacity) != 0)
+        {
+            throw std::runtime_error("Failed to grow the transcript file.");
+        }
+
+        void* mapped = mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0);
+        if (mapped == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map the transcript file.");
+        }
+        m_mapping = (uint8_t*)mapped;
+#endif
+        m_capacity = newCapacity;
+    }
+
+private:
+#if defined(_WIN32)
+    HANDLE m_fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE m_mappingHandle = nullptr;
+#else
+    int m_fileDescriptor = -1;
+#endif
+    uint8_t* m_mapping = nullptr;
+    size_t m_capacity = 0;
+    uint64_t m_used = 0;
+    size_t m_growthStep;
+};
+
+// Appends transcript records to '<fileName>' and index entries to
+// '<fileName>.idx'. Append() is a pair of memcpys into the mappings — no
+// formatting, no syscalls on the hot path — and like AsyncTranscriptWriter it
+// expects to be called from a single thread (the SDK dispatches its events
+// serially).
+class BinaryTranscriptWriter final
+{
+public:
+
+    explicit BinaryTranscriptWriter(const std::string& fileName)
+        : m_data(fileName, 1024 * 1024), m_index(fileName + ".idx", 64 * 1024)
+    {
+    }
+
+    // Appends one record; 'reason' is the numeric ResultReason.
+    void Append(const std::string& sessionId, uint64_t offsetTicks, uint64_t durationTicks,
+        int reason, const std::string& text)
+    {
+        BinaryTranscriptRecord record = {};
+        record.OffsetTicks = offsetTicks;
+        record.DurationTicks = durationTicks;
+        record.Reason = (uint32_t)reason;
+        record.TextBytes = (uint32_t)text.size();
+        memcpy(record.SessionId, sessionId.data(),
+            sessionId.size() < sizeof(record.SessionId) ? sessionId.size() : sizeof(record.SessionId));
+
+        BinaryTranscriptIndexEntry entry;
+        entry.OffsetTicks = offsetTicks;
+        entry.RecordPosition = m_data.Append(&record, sizeof(record));
+        m_data.Append(text.data(), text.size());
+        m_index.Append(&entry, sizeof(entry));
+    }
+
+    // Trims both files to their appended lengths and closes them.
+    void Close()
+    {
+        m_data.Close();
+        m_index.Close();
+    }
+
+private:
+    MappedAppendFile m_data;
+    MappedAppendFile m_index;
+};
+
+// Read side of the format: maps the data and index files and serves records
+// by index position or by time offset. This is the same lookup a downstream
+// consumer would implement over the mapped bytes.
+class BinaryTranscriptReader final
+{
+public:
+
+    explicit BinaryTranscriptReader(const std::string& fileName)
+    {
+        MapFile(fileName, &m_data, &m_dataSize);
+        try
+        {
+            MapFile(fileName + ".idx", &m_indexData, &m_indexSize);
+        }
+        catch (...)
+        {
+            Unmap(m_data, m_dataSize);
+            throw;
+        }
+    }
+
+    ~BinaryTranscriptReader()
+    {
+        Unmap(m_indexData, m_indexSize);
+        Unmap(m_data, m_dataSize);
+    }
+
+    BinaryTranscriptReader(const BinaryTranscriptReader&) = delete;
+    BinaryTranscriptReader& operator=(const BinaryTranscriptReader&) = delete;
+
+    // Gets the number of records.
+    size_t Count() const
+    {
+        return m_indexSize / sizeof(BinaryTranscriptIndexEntry);
+    }
+
+    // Gets the header of record 'position' and points 'text'/'textBytes' at
+    // its UTF-8 payload inside the mapping (zero copy).
+    const BinaryTranscriptRecord* Get(size_t position, const char** text, size_t* textBytes) const
+    {
+        const BinaryTranscriptIndexEntry* entries = (const BinaryTranscriptIndexEntry*)m_indexData;
+        if (position >= Count() || entries[position].RecordPosition + sizeof(BinaryTranscriptRecord) > m_dataSize)
+        {
+            throw std::out_of_range("Transcript record position out of range.");
+        }
+
+        const BinaryTranscriptRecord* record =
+            (const BinaryTranscriptRecord*)(m_data + entries[position].RecordPosition);
+        *text = (const char*)(record + 1);
+        *textBytes = record->TextBytes;
+        return record;
+    }
+
+    // Binary-searches the index for the first record whose offset is at or
+    // after 'offsetTicks'; returns Count() when every record is earlier.
+    size_t FindFirstAtOrAfter(uint64_t offsetTicks) const
+    {
+        const BinaryTranscriptIndexEntry* entries = (const BinaryTranscriptIndexEntry*)m_indexData;
+        size_t low = 0;
+        size_t high = Count();
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (entries[middle].OffsetTicks < offsetTicks)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+private:
+    static void MapFile(const std::string& fileName, const uint8_t** data, size_t* size)
+    {
+        *data = nullptr;
+        *size = 0;
+#if defined(_WIN32)
+        HANDLE fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            throw std::invalid_argument("Cannot open transcript file '" + fileName + "'.");
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(fileHandle);
+            return; // an empty transcript has zero records.
+        }
+
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr)
+        {
+            CloseHandle(fileHandle);
+            throw std::runtime_error("Failed to map transcript file '" + fileName + "'.");
+        }
+
+        *data = (const uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        *size = (size_t)fileSize.QuadPart;
+
+        // The mapping keeps both handles alive.
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        if (*data == nullptr)
+        {
+            throw std::runtime_error("Failed to map transcript file '" + fileName + "'.");
+        }
+#else
+        int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            throw std::invalid_argument("Cannot open transcript file '" + fileName + "'.");
+        }
+
+        struct stat fileStat;
+        if (fstat(fileDescriptor, &fileStat) != 0)
+        {
+            close(fileDescriptor);
+            throw std::runtime_error("Failed to map transcript file '" + fileName + "'.");
+        }
+        if (fileStat.st_size == 0)
+        {
+            close(fileDescriptor);
+            return; // an empty transcript has zero records.
+        }
+
+        void* mapped = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        close(fileDescriptor); // the mapping keeps its own reference.
+        if (mapped == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map transcript file '" + fileName + "'.");
+        }
+        *data = (const uint8_t*)mapped;
+        *size = (size_t)fileStat.st_size;
+#endif
+    }
+
+    static void Unmap(const uint8_t* data, size_t size)
+    {
+        if (data == nullptr)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+        (void)size;
+#else
+        munmap((void*)data, size);
+#endif
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_dataSize = 0;
+    const uint8_t* m_indexData = nullptr;
+    size_t m_indexSize = 0;
+};
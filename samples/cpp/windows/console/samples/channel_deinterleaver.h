@@ -0,0 +1,155 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define CHANNEL_DEINTERLEAVER_USE_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CHANNEL_DEINTERLEAVER_USE_NEON 1
+#endif
+
+// Deinterleaves 8-channel 16-bit PCM (the conversation transcriber's device
+// format) into per-channel buffers, and interleaves it back. An 8-sample frame
+// is exactly one 128-bit register, so eight frames form an 8x8 int16 matrix
+// that a register transpose turns into eight channel vectors; the same
+// transpose also performs interleaving with source and destination swapped.
+// Scalar per-sample shuffling of this format costs a full core per meeting.
+class ChannelDeinterleaver final
+{
+public:
+    static constexpr size_t Channels = 8;
+
+    // Splits 'frames' frames of interleaved audio into the 8 buffers in
+    // 'channels', each of which must hold at least 'frames' samples.
+    static void Deinterleave(const int16_t* interleaved, int16_t* const channels[Channels], size_t frames)
+    {
+        size_t frame = 0;
+#if defined(CHANNEL_DEINTERLEAVER_USE_SSE2) || defined(CHANNEL_DEINTERLEAVER_USE_NEON)
+        for (; frame + 8 <= frames; frame += 8)
+        {
+            int16_t transposed[Channels * 8];
+            Transpose8x8(interleaved + frame * Channels, transposed);
+            for (size_t channel = 0; channel < Channels; channel++)
+            {
+                memcpy(channels[channel] + frame, transposed + channel * 8, 8 * sizeof(int16_t));
+            }
+        }
+#endif
+        for (; frame < frames; frame++)
+        {
+            for (size_t channel = 0; channel < Channels; channel++)
+            {
+                channels[channel][frame] = interleaved[frame * Channels + channel];
+            }
+        }
+    }
+
+    // Merges the 8 per-channel buffers back into interleaved frames;
+    // 'interleaved' must hold at least 'frames' * 8 samples.
+    static void Interleave(const int16_t* const channels[Channels], int16_t* interleaved, size_t frames)
+    {
+        size_t frame = 0;
+#if defined(CHANNEL_DEINTERLEAVER_USE_SSE2) || defined(CHANNEL_DEINTERLEAVER_USE_NEON)
+        for (; frame + 8 <= frames; frame += 8)
+        {
+            int16_t gathered[Channels * 8];
+            for (size_t channel = 0; channel < Channels; channel++)
+            {
+                memcpy(gathered + channel * 8, channels[channel] + frame, 8 * sizeof(int16_t));
+            }
+            Transpose8x8(gathered, interleaved + frame * Channels);
+        }
+#endif
+        for (; frame < frames; frame++)
+        {
+            for (size_t channel = 0; channel < Channels; channel++)
+            {
+                interleaved[frame * Channels + channel] = channels[channel][frame];
+            }
+        }
+    }
+
+private:
+#if defined(CHANNEL_DEINTERLEAVER_USE_SSE2)
+    // Transposes an 8x8 int16 matrix held in eight rows of one register each,
+    // using the classic three-stage unpack network.
+    static void Transpose8x8(const int16_t* source, int16_t* destination)
+    {
+        __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 0 * 8));
+        __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 1 * 8));
+        __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 2 * 8));
+        __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 3 * 8));
+        __m128i row4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 4 * 8));
+        __m128i row5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 5 * 8));
+        __m128i row6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 6 * 8));
+        __m128i row7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 7 * 8));
+
+        __m128i pair0 = _mm_unpacklo_epi16(row0, row1);
+        __m128i pair1 = _mm_unpackhi_epi16(row0, row1);
+        __m128i pair2 = _mm_unpacklo_epi16(row2, row3);
+        __m128i pair3 = _mm_unpackhi_epi16(row2, row3);
+        __m128i pair4 = _mm_unpacklo_epi16(row4, row5);
+        __m128i pair5 = _mm_unpackhi_epi16(row4, row5);
+        __m128i pair6 = _mm_unpacklo_epi16(row6, row7);
+        __m128i pair7 = _mm_unpackhi_epi16(row6, row7);
+
+        __m128i quad0 = _mm_unpacklo_epi32(pair0, pair2);
+        __m128i quad1 = _mm_unpackhi_epi32(pair0, pair2);
+        __m128i quad2 = _mm_unpacklo_epi32(pair1, pair3);
+        __m128i quad3 = _mm_unpackhi_epi32(pair1, pair3);
+        __m128i quad4 = _mm_unpacklo_epi32(pair4, pair6);
+        __m128i quad5 = _mm_unpackhi_epi32(pair4, pair6);
+        __m128i quad6 = _mm_unpacklo_epi32(pair5, pair7);
+        __m128i quad7 = _mm_unpackhi_epi32(pair5, pair7);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 0 * 8), _mm_unpacklo_epi64(quad0, quad4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 1 * 8), _mm_unpackhi_epi64(quad0, quad4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 2 * 8), _mm_unpacklo_epi64(quad1, quad5));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 3 * 8), _mm_unpackhi_epi64(quad1, quad5));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 4 * 8), _mm_unpacklo_epi64(quad2, quad6));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 5 * 8), _mm_unpackhi_epi64(quad2, quad6));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 6 * 8), _mm_unpacklo_epi64(quad3, quad7));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 7 * 8), _mm_unpackhi_epi64(quad3, quad7));
+    }
+#elif defined(CHANNEL_DEINTERLEAVER_USE_NEON)
+    // Transposes an 8x8 int16 matrix with the NEON transpose/zip network.
+    static void Transpose8x8(const int16_t* source, int16_t* destination)
+    {
+        int16x8_t row0 = vld1q_s16(source + 0 * 8);
+        int16x8_t row1 = vld1q_s16(source + 1 * 8);
+        int16x8_t row2 = vld1q_s16(source + 2 * 8);
+        int16x8_t row3 = vld1q_s16(source + 3 * 8);
+        int16x8_t row4 = vld1q_s16(source + 4 * 8);
+        int16x8_t row5 = vld1q_s16(source + 5 * 8);
+        int16x8_t row6 = vld1q_s16(source + 6 * 8);
+        int16x8_t row7 = vld1q_s16(source + 7 * 8);
+
+        int16x8x2_t pair01 = vtrnq_s16(row0, row1);
+        int16x8x2_t pair23 = vtrnq_s16(row2, row3);
+        int16x8x2_t pair45 = vtrnq_s16(row4, row5);
+        int16x8x2_t pair67 = vtrnq_s16(row6, row7);
+
+        int32x4x2_t quad02 = vtrnq_s32(vreinterpretq_s32_s16(pair01.val[0]), vreinterpretq_s32_s16(pair23.val[0]));
+        int32x4x2_t quad13 = vtrnq_s32(vreinterpretq_s32_s16(pair01.val[1]), vreinterpretq_s32_s16(pair23.val[1]));
+        int32x4x2_t quad46 = vtrnq_s32(vreinterpretq_s32_s16(pair45.val[0]), vreinterpretq_s32_s16(pair67.val[0]));
+        int32x4x2_t quad57 = vtrnq_s32(vreinterpretq_s32_s16(pair45.val[1]), vreinterpretq_s32_s16(pair67.val[1]));
+
+        vst1q_s16(destination + 0 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(quad02.val[0]), vget_low_s32(quad46.val[0]))));
+        vst1q_s16(destination + 1 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(quad13.val[0]), vget_low_s32(quad57.val[0]))));
+        vst1q_s16(destination + 2 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(quad02.val[1]), vget_low_s32(quad46.val[1]))));
+        vst1q_s16(destination + 3 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(quad13.val[1]), vget_low_s32(quad57.val[1]))));
+        vst1q_s16(destination + 4 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(quad02.val[0]), vget_high_s32(quad46.val[0]))));
+        vst1q_s16(destination + 5 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(quad13.val[0]), vget_high_s32(quad57.val[0]))));
+        vst1q_s16(destination + 6 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(quad02.val[1]), vget_high_s32(quad46.val[1]))));
+        vst1q_s16(destination + 7 * 8, vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(quad13.val[1]), vget_high_s32(quad57.val[1]))));
+    }
+#endif
+};
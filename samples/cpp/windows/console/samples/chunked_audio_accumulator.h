@@ -0,0 +1,101 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "audio_buffer_pool.h"
+
+// Accumulates synthesized audio as a list of fixed-size chunks leased from a
+// buffer pool. Growing a single contiguous vector copies O(n^2) bytes over a
+// long synthesis and stalls the delivery thread whenever the vector
+// reallocates; appending here only ever fills the tail chunk and leases a new
+// one when it is full, so accumulation never reallocates or copies existing
+// data. Consumers either walk the chunks in place with ForEachSpan() or
+// request a one-time contiguous copy with Flatten().
+class ChunkedAudioAccumulator final
+{
+public:
+
+    // 'chunkSize' is the size of each pooled chunk. Chunks are recycled through
+    // the accumulator's own pool, so repeated syntheses reuse the same storage.
+    explicit ChunkedAudioAccumulator(size_t chunkSize = 64 * 1024)
+        : m_pool(chunkSize, 16), m_chunkSize(chunkSize)
+    {
+    }
+
+    // Appends a block of audio, leasing additional chunks as needed.
+    void Append(const uint8_t* data, size_t size)
+    {
+        while (size > 0)
+        {
+            if (m_chunks.empty() || m_tailUsed == m_chunkSize)
+            {
+                m_chunks.push_back(m_pool.Acquire());
+                m_tailUsed = 0;
+            }
+
+            auto& tail = m_chunks.back();
+            size_t copied = size < m_chunkSize - m_tailUsed ? size : m_chunkSize - m_tailUsed;
+            memcpy(tail.Data() + m_tailUsed, data, copied);
+            m_tailUsed += copied;
+            m_totalSize += copied;
+            data += copied;
+            size -= copied;
+        }
+    }
+
+    // Total number of accumulated bytes.
+    size_t Size() const
+    {
+        return m_totalSize;
+    }
+
+    // Invokes 'visitor(data, size)' for each filled span in order, without
+    // flattening. This is the zero-copy way to hand the audio to a writer.
+    template <typename Visitor>
+    void ForEachSpan(Visitor visitor)
+    {
+        for (size_t i = 0; i < m_chunks.size(); i++)
+        {
+            size_t filled = (i + 1 == m_chunks.size()) ? m_tailUsed : m_chunkSize;
+            if (filled > 0)
+            {
+                visitor(m_chunks[i].Data(), filled);
+            }
+        }
+    }
+
+    // Copies the accumulated audio into one contiguous vector. This is the only
+    // place the audio is copied; use it when a consumer needs flat storage.
+    std::shared_ptr<std::vector<uint8_t>> Flatten()
+    {
+        auto flat = std::make_shared<std::vector<uint8_t>>();
+        flat->reserve(m_totalSize);
+        ForEachSpan([&flat](const uint8_t* data, size_t size)
+        {
+            flat->insert(flat->end(), data, data + size);
+        });
+        return flat;
+    }
+
+    // Returns all chunks to the pool and resets the accumulator.
+    void Clear()
+    {
+        m_chunks.clear();
+        m_tailUsed = 0;
+        m_totalSize = 0;
+    }
+
+private:
+    AudioBufferPool m_pool;
+    size_t m_chunkSize;
+    std::vector<AudioBufferPool::Lease> m_chunks;
+    size_t m_tailUsed = 0;
+    size_t m_totalSize = 0;
+};
@@ -0,0 +1,116 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Moves console output off the SDK's event dispatch threads. Handlers enqueue event
+// records into a bounded multi-producer queue and return immediately; a dedicated
+// consumer thread performs the (potentially blocking) terminal writes. When the
+// terminal cannot keep up the queue drops new records instead of stalling the SDK,
+// and reports how many were dropped.
+class ConsoleEventWriter final
+{
+public:
+
+    // The process-wide writer shared by all sample event handlers.
+    static ConsoleEventWriter& Shared()
+    {
+        static ConsoleEventWriter writer;
+        return writer;
+    }
+
+    // Enqueues one output line. Never blocks: if the queue is full the record is
+    // dropped and counted, so a slow terminal cannot back up into the SDK.
+    void Write(std::string line)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_queue.size() >= maxQueuedRecords)
+            {
+                m_droppedRecords++;
+                return;
+            }
+            m_queue.push_back(std::move(line));
+        }
+        m_recordReady.notify_one();
+    }
+
+    // Waits until everything enqueued so far has been written to the terminal.
+    void Flush()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queueDrained.wait(lock, [this] { return m_queue.empty() && !m_writing; });
+        if (m_droppedRecords > 0)
+        {
+            std::cout << "[" << m_droppedRecords << " event records dropped by slow terminal]" << std::endl;
+            m_droppedRecords = 0;
+        }
+    }
+
+    ConsoleEventWriter(const ConsoleEventWriter&) = delete;
+    ConsoleEventWriter& operator=(const ConsoleEventWriter&) = delete;
+
+private:
+    static constexpr size_t maxQueuedRecords = 1024;
+
+    ConsoleEventWriter()
+    {
+        m_consumer = std::thread(&ConsoleEventWriter::ConsumeRecords, this);
+    }
+
+    ~ConsoleEventWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+        m_recordReady.notify_all();
+        m_consumer.join();
+    }
+
+    void ConsumeRecords()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_recordReady.wait(lock, [this] { return !m_queue.empty() || m_shutdown; });
+            if (m_queue.empty() && m_shutdown)
+            {
+                return;
+            }
+
+            std::string line = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_writing = true;
+
+            // The terminal write happens outside the lock, so producers never wait on it.
+            lock.unlock();
+            std::cout << line << std::endl;
+            lock.lock();
+
+            m_writing = false;
+            if (m_queue.empty())
+            {
+                m_queueDrained.notify_all();
+            }
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_recordReady;
+    std::condition_variable m_queueDrained;
+    std::deque<std::string> m_queue;
+    size_t m_droppedRecords = 0;
+    bool m_writing = false;
+    bool m_shutdown = false;
+    std::thread m_consumer;
+};
@@ -8,7 +8,20 @@
 #include <speechapi_cxx.h>
 #include <fstream>
 #include "wav_file_reader.h"
+#include "prefetching_wav_file_reader.h"
+#include "audio_buffer_pool.h"
+#include "channel_deinterleaver.h"
+#include "console_event_writer.h"
+#include "double_buffered_file_writer.h"
+#include "metrics_writer.h"
+#include "stream_counters.h"
+#include "binary_transcript.h"
+#include "transcript_writer.h"
+#include "voice_signature_cache.h"
 #include <chrono>
+#include <memory>
+#include <sstream>
+#include <vector>
 
 using namespace std;
 using namespace Microsoft::CognitiveServices::Speech;
@@ -23,7 +36,9 @@ void ConversationWithPullAudioStream()
     // First, define your own pull audio input stream callback class that implements the
     // PullAudioInputStreamCallback interface. The sample here illustrates how to define such
     // a callback that reads audio data from a wav file.
-    // AudioInputFromFileCallback implements PullAudioInputStreamCallback interface, and uses a wav file as source
+    // AudioInputFromFileCallback implements PullAudioInputStreamCallback interface, and uses a wav file as source.
+    // The file is read by a prefetching reader, so disk I/O happens on a background thread and
+    // Read() only waits when the producer is genuinely behind.
     class AudioInputFromFileCallback final : public PullAudioInputStreamCallback
     {
     public:
@@ -31,6 +46,15 @@ void ConversationWithPullAudioStream()
         AudioInputFromFileCallback(const string& audioFileName)
             : m_reader(audioFileName)
         {
+            // One double-buffered writer per channel: each chunk's transposed
+            // samples go to disk as they are produced, overlapping with the
+            // next Read(), so memory stays bounded by the chunk size instead
+            // of growing with the length of the meeting.
+            for (size_t channel = 0; channel < ChannelDeinterleaver::Channels; channel++)
+            {
+                m_channelFiles[channel] = std::make_unique<DoubleBufferedFileWriter>(
+                    "katiesteve_ch" + to_string(channel) + ".pcm");
+            }
         }
         // Implements AudioInputStream::Read() which is called to get data from the audio stream.
         // It copies data available in the stream to 'dataBuffer', but no more than 'size' bytes.
@@ -40,16 +64,69 @@ void ConversationWithPullAudioStream()
         // It returns 0 to indicate that the stream reaches end or is closed.
         int Read(uint8_t* dataBuffer, uint32_t size) override
         {
-            return m_reader.Read(dataBuffer, size);
+            // With the prefetcher warm this is a copy; any time recorded here
+            // means the producer fell behind the SDK's pull thread.
+            auto blockedFrom = chrono::steady_clock::now();
+            int bytesRead = m_reader.Read(dataBuffer, size);
+            StreamCounters::Shared().AddReadBlocked(chrono::steady_clock::now() - blockedFrom);
+            if (bytesRead > 0)
+            {
+                // Splits the chunk into per-channel mono copies in the same
+                // pass that feeds the pull stream; the vectorized transpose
+                // keeps this far below the cost of per-sample shuffling.
+                DeinterleaveChunk(dataBuffer, (size_t)bytesRead);
+            }
+            return bytesRead;
         }
         // Implements AudioInputStream::Close() which is called when the stream needs to be closed.
+        // Flushes whatever the channel writers still have buffered.
         void Close() override
         {
             m_reader.Close();
+            for (size_t channel = 0; channel < ChannelDeinterleaver::Channels; channel++)
+            {
+                m_channelFiles[channel]->Close();
+            }
         }
 
     private:
-        WavFileReader m_reader;
+        void DeinterleaveChunk(const uint8_t* data, size_t bytes)
+        {
+            // Carries any partial frame over to the next chunk so the
+            // transpose always sees whole 8-channel frames.
+            m_carry.insert(m_carry.end(), data, data + bytes);
+            constexpr size_t frameBytes = ChannelDeinterleaver::Channels * sizeof(int16_t);
+            size_t frames = m_carry.size() / frameBytes;
+            if (frames == 0)
+            {
+                return;
+            }
+
+            // The scratch buffers are reused across chunks; resize only grows
+            // them to the largest chunk seen, so steady state allocates nothing.
+            int16_t* channels[ChannelDeinterleaver::Channels];
+            for (size_t channel = 0; channel < ChannelDeinterleaver::Channels; channel++)
+            {
+                m_transposed[channel].resize(frames);
+                channels[channel] = m_transposed[channel].data();
+            }
+            ChannelDeinterleaver::Deinterleave(reinterpret_cast<const int16_t*>(m_carry.data()), channels, frames);
+
+            // Hands each channel's slice to its writer; the disk write happens
+            // on the writer's thread, not on the SDK's pull thread.
+            for (size_t channel = 0; channel < ChannelDeinterleaver::Channels; channel++)
+            {
+                m_channelFiles[channel]->Write(
+                    reinterpret_cast<const uint8_t*>(m_transposed[channel].data()), frames * sizeof(int16_t));
+            }
+            m_carry.erase(m_carry.begin(), m_carry.begin() + frames * frameBytes);
+        }
+
+    private:
+        PrefetchingWavFileReader m_reader;
+        std::vector<uint8_t> m_carry;
+        std::vector<int16_t> m_transposed[ChannelDeinterleaver::Channels];
+        std::unique_ptr<DoubleBufferedFileWriter> m_channelFiles[ChannelDeinterleaver::Channels];
     };
 
     // Creates an instance of a speech config with your subscription key and region.
@@ -99,11 +176,20 @@ void ConversationWithPullAudioStream()
                   "Data": "DizY04Z7PH/sYu2Yw2EcL4Mvj1GnEDOWJ/DhXHGdQJsQ8/zDc13z1cwllbEo5OSr3oGoKEHLV95OUA6PgksZzvTkf42iOFEv3yifUNfYkZuIzStZoDxWu1H1BoFBejqzSpCYyvqLwilWOyUeMn+z+E4+zXjqHUCyYJ/xf0C3+58kCbmyA55yj7YZ6OtMVyFmfT2GLiXr4YshUB14dgwl3Y08SRNavnG+/QOs+ixf3UoZ6BC1VZcVQnC2tn2FB+8v6ehnIOTQedo++6RWIB0RYmQ8VaEeI0E4hkpA1OxQ9f2gBVtw3KZXWSWBz8sXig2igpwMsQoFRmmIOGsu+p6tM8/OThQpARZ7OyAxsurzmaSGZAaXYt0YwMdIIXKeDBF6/KnUyw+NNzku1875u2Fde/bxgVvCOwhrLPPuu/RZUeAkwVQge7nKYNW5YjDcz8mfg4LfqWEGOVCcmf2IitQtcIEjY3MwLVNvsAB6GT2es1/1QieCfQKy/Tdu8IUfEvekwSCxSlWhfVrLjRhGeWa9idCjsngQbNkqYUNdnIlidkn2DC4BavSTYXR5lVxV4SR/Vvj8h4N5nP/URPDhkzl7n7Tqd4CGFZDzZzAr7yRo3PeUBX0CmdrKLW3+GIXAdvpFAx592pB0ySCv5qBFhJNErEINawfGcmeWZSORxJg1u+agj51zfTdrHZeugFcMs6Be"
                  })";
 
+    // Looks the signatures up in the on-disk cache first, keyed by speaker and
+    // enrollment audio; the generator lambda is where the signature REST call
+    // goes and only runs for speakers the cache has not seen.
+    VoiceSignatureCache signatureCache(".");
+    auto signatureKatie = signatureCache.GetOrCreate("katie@example.com", "enrollment_audio_katie.wav",
+        [&voiceSignatureKatie]() { return voiceSignatureKatie; });
+    auto signatureSteve = signatureCache.GetOrCreate("steve@example.com", "enrollment_audio_steve.wav",
+        [&voiceSignatureSteve]() { return voiceSignatureSteve; });
+
     // creates a participant
-    auto katie = Participant::From("katie@example.com", "en-us", voiceSignatureKatie);
+    auto katie = Participant::From("katie@example.com", "en-us", signatureKatie);
 
     // creates another participant
-    auto steve = Participant::From("steve@example.com", "en-us", voiceSignatureSteve);
+    auto steve = Participant::From("steve@example.com", "en-us", signatureSteve);
 
     // Adds katie as a participant to the conversation.
     conversation->AddParticipantAsync(katie).get();
@@ -114,24 +200,50 @@ void ConversationWithPullAudioStream()
     // a promise for synchronization of recognition end.
     promise<void> recognitionEnd;
 
-    // Subscribes to events.
-    recognizer->Transcribing.Connect([](const ConversationTranscriptionEventArgs& e)
+    // Transcript records go to a file through the bounded async writer, so a
+    // multi-hour meeting never does file I/O on the SDK callback thread.
+    AsyncTranscriptWriter transcriptWriter("conversation_transcript.tsv");
+
+    // Machine-readable transcript in parallel: fixed-header records plus an
+    // offset index, so post-processing seeks by time instead of re-parsing
+    // the text output.
+    BinaryTranscriptWriter binaryTranscript("conversation_transcript.bin");
+
+    // Subscribes to events. Handlers enqueue records for the shared console
+    // writer instead of blocking the SDK's dispatch thread on terminal I/O.
+    recognizer->Transcribing.Connect([&transcriptWriter](const ConversationTranscriptionEventArgs& e)
     {
-        cout << "TRANSCRIBING: Text=" << e.Result->Text << std::endl;
+        transcriptWriter.Append(e.Result->UserId, e.Result->Offset(), e.Result->Text);
+        if (MetricsWriter::Shared().Enabled())
+        {
+            MetricsWriter::Shared().Emit(e.SessionId, "transcribing", e.Result->Offset());
+            return;
+        }
+        ConsoleEventWriter::Shared().Write("TRANSCRIBING: Text=" + e.Result->Text);
     });
 
-    recognizer->Transcribed.Connect([](const ConversationTranscriptionEventArgs& e)
+    recognizer->Transcribed.Connect([&transcriptWriter, &binaryTranscript](const ConversationTranscriptionEventArgs& e)
     {
         if (e.Result->Reason == ResultReason::RecognizedSpeech)
         {
-            cout << "Transcribed: Text=" << e.Result->Text << std::endl
-                << "  Offset=" << e.Result->Offset() << std::endl
-                << "  Duration=" << e.Result->Duration() << std::endl
-                << "  UserId=" << e.Result->UserId << std::endl;
+            transcriptWriter.Append(e.Result->UserId, e.Result->Offset(), e.Result->Text);
+            binaryTranscript.Append(e.SessionId, e.Result->Offset(), e.Result->Duration(),
+                (int)e.Result->Reason, e.Result->Text);
+            if (MetricsWriter::Shared().Enabled())
+            {
+                MetricsWriter::Shared().Emit(e.SessionId, "transcribed", e.Result->Offset(), e.Result->Duration());
+                return;
+            }
+            ostringstream record;
+            record << "Transcribed: Text=" << e.Result->Text << "\n"
+                << "  Offset=" << e.Result->Offset() << "\n"
+                << "  Duration=" << e.Result->Duration() << "\n"
+                << "  UserId=" << e.Result->UserId;
+            ConsoleEventWriter::Shared().Write(record.str());
         }
         else if (e.Result->Reason == ResultReason::NoMatch)
         {
-            cout << "NOMATCH: Speech could not be recognized." << std::endl;
+            ConsoleEventWriter::Shared().Write("NOMATCH: Speech could not be recognized.");
         }
     });
 
@@ -154,9 +266,10 @@ void ConversationWithPullAudioStream()
         }
     });
 
-    recognizer->SessionStopped.Connect([&recognitionEnd](const SessionEventArgs& e)
+    recognizer->SessionStopped.Connect([&recognitionEnd, &transcriptWriter](const SessionEventArgs& e)
     {
         cout << "SESSION: " << e.SessionId << " stopped." << std::endl;
+        transcriptWriter.Flush(); // Everything queued reaches the file before the session ends.
         recognitionEnd.set_value(); // Notify to stop recognition.
     });
 
@@ -168,6 +281,11 @@ void ConversationWithPullAudioStream()
 
     // Stops transcribing. This is optional.
     recognizer->StopTranscribingAsync().wait();
+
+    // Makes sure all queued event output reaches the terminal and the file.
+    ConsoleEventWriter::Shared().Flush();
+    transcriptWriter.Close();
+    binaryTranscript.Close();
 }
 
 // Transcribing conversation using a push audio stream
@@ -202,11 +320,20 @@ void ConversationWithPushAudioStream()
                   "Data": "DizY04Z7PH/sYu2Yw2EcL4Mvj1GnEDOWJ/DhXHGdQJsQ8/zDc13z1cwllbEo5OSr3oGoKEHLV95OUA6PgksZzvTkf42iOFEv3yifUNfYkZuIzStZoDxWu1H1BoFBejqzSpCYyvqLwilWOyUeMn+z+E4+zXjqHUCyYJ/xf0C3+58kCbmyA55yj7YZ6OtMVyFmfT2GLiXr4YshUB14dgwl3Y08SRNavnG+/QOs+ixf3UoZ6BC1VZcVQnC2tn2FB+8v6ehnIOTQedo++6RWIB0RYmQ8VaEeI0E4hkpA1OxQ9f2gBVtw3KZXWSWBz8sXig2igpwMsQoFRmmIOGsu+p6tM8/OThQpARZ7OyAxsurzmaSGZAaXYt0YwMdIIXKeDBF6/KnUyw+NNzku1875u2Fde/bxgVvCOwhrLPPuu/RZUeAkwVQge7nKYNW5YjDcz8mfg4LfqWEGOVCcmf2IitQtcIEjY3MwLVNvsAB6GT2es1/1QieCfQKy/Tdu8IUfEvekwSCxSlWhfVrLjRhGeWa9idCjsngQbNkqYUNdnIlidkn2DC4BavSTYXR5lVxV4SR/Vvj8h4N5nP/URPDhkzl7n7Tqd4CGFZDzZzAr7yRo3PeUBX0CmdrKLW3+GIXAdvpFAx592pB0ySCv5qBFhJNErEINawfGcmeWZSORxJg1u+agj51zfTdrHZeugFcMs6Be"
                  })";
 
+    // Looks the signatures up in the on-disk cache first, keyed by speaker and
+    // enrollment audio; the generator lambda is where the signature REST call
+    // goes and only runs for speakers the cache has not seen.
+    VoiceSignatureCache signatureCache(".");
+    auto signatureKatie = signatureCache.GetOrCreate("katie@example.com", "enrollment_audio_katie.wav",
+        [&voiceSignatureKatie]() { return voiceSignatureKatie; });
+    auto signatureSteve = signatureCache.GetOrCreate("steve@example.com", "enrollment_audio_steve.wav",
+        [&voiceSignatureSteve]() { return voiceSignatureSteve; });
+
     // creates a participant
-    auto katie = Participant::From("katie@example.com", "en-us", voiceSignatureKatie);
+    auto katie = Participant::From("katie@example.com", "en-us", signatureKatie);
 
     // creates another participant
-    auto steve = Participant::From("steve@example.com", "en-us", voiceSignatureSteve);
+    auto steve = Participant::From("steve@example.com", "en-us", signatureSteve);
 
     // adds katie as a participant to the conversation.
     conversation->AddParticipantAsync(katie).get();
@@ -217,24 +344,27 @@ void ConversationWithPushAudioStream()
     // promise for synchronization of recognition end.
     promise<void> recognitionEnd;
 
-    // Subscribes to events.
+    // Subscribes to events. Handlers enqueue records for the shared console
+    // writer instead of blocking the SDK's dispatch thread on terminal I/O.
     recognizer->Transcribing.Connect([](const ConversationTranscriptionEventArgs& e)
     {
-        cout << "TRANSCRIBING: Text=" << e.Result->Text << std::endl;
+        ConsoleEventWriter::Shared().Write("TRANSCRIBING: Text=" + e.Result->Text);
     });
 
     recognizer->Transcribed.Connect([](const ConversationTranscriptionEventArgs& e)
     {
         if (e.Result->Reason == ResultReason::RecognizedSpeech)
         {
-            cout << "RECOGNIZED: Text=" << e.Result->Text << std::endl
-                << "  Offset=" << e.Result->Offset() << std::endl
-                << "  Duration=" << e.Result->Duration() << std::endl
-                << "  UserId=" << e.Result->UserId << std::endl;
+            ostringstream record;
+            record << "RECOGNIZED: Text=" << e.Result->Text << "\n"
+                << "  Offset=" << e.Result->Offset() << "\n"
+                << "  Duration=" << e.Result->Duration() << "\n"
+                << "  UserId=" << e.Result->UserId;
+            ConsoleEventWriter::Shared().Write(record.str());
         }
         else if (e.Result->Reason == ResultReason::NoMatch)
         {
-            cout << "NOMATCH: Speech could not be recognized." << std::endl;
+            ConsoleEventWriter::Shared().Write("NOMATCH: Speech could not be recognized.");
         }
     });
 
@@ -272,15 +402,21 @@ void ConversationWithPushAudioStream()
     // The audio file should be in a format of 16 kHz sampling rate, 16 bits per sample, and 8 channels.
     try
     {
-        WavFileReader reader("katiesteve.wav");
-        vector<uint8_t> buffer(1000);
+        // Sequential-read mode: Read() calls are serviced from a 1 MB block buffer,
+        // so the many small reads below do not turn into many small syscalls.
+        WavFileReader reader("katiesteve.wav", 1024 * 1024);
+
+        // Leases a recycled feed buffer from the shared pool instead of allocating
+        // a fresh vector per session.
+        auto buffer = AudioBufferPool::Shared().Acquire();
 
         // Read data and push them into the stream
         int readSamples = 0;
-        while ((readSamples = reader.Read(buffer.data(), (uint32_t)buffer.size())) != 0)
+        while ((readSamples = reader.Read(buffer.Data(), (uint32_t)buffer.Size())) != 0)
         {
             // Push a buffer into the stream
-            pushStream->Write(buffer.data(), readSamples);
+            pushStream->Write(buffer.Data(), readSamples);
+            StreamCounters::Shared().AddBytesPushed(readSamples);
             this_thread::sleep_for(10ms);
         }
     }
@@ -297,4 +433,7 @@ void ConversationWithPushAudioStream()
 
     // Leaves the conversation.
     recognizer->StopTranscribingAsync().wait();
+
+    // Makes sure all queued event output reaches the terminal.
+    ConsoleEventWriter::Shared().Flush();
 }
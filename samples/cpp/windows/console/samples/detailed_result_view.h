@@ -0,0 +1,406 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A borrowed view of a substring of the JSON payload: pointer plus length, no
+// copy. (std::string_view is C++17; the samples build as C++14, so this is
+// the minimal equivalent.) The bytes are the raw JSON string contents, with
+// escape sequences left in place; ToString() materializes an unescaped copy
+// for the rare value that needs one.
+class JsonStringView final
+{
+public:
+
+    JsonStringView() : m_data(nullptr), m_size(0) {}
+    JsonStringView(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+    const char* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    bool Empty() const { return m_size == 0; }
+
+    bool operator==(const char* text) const
+    {
+        return strlen(text) == m_size && memcmp(m_data, text, m_size) == 0;
+    }
+
+    // Unescaping copy; the only place a string is materialized.
+    std::string ToString() const
+    {
+        std::string result;
+        result.reserve(m_size);
+        for (size_t i = 0; i < m_size; i++)
+        {
+            if (m_data[i] != '\\' || i + 1 == m_size)
+            {
+                result.push_back(m_data[i]);
+                continue;
+            }
+            switch (m_data[++i])
+            {
+            case 'n': result.push_back('\n'); break;
+            case 't': result.push_back('\t'); break;
+            case 'r': result.push_back('\r'); break;
+            case 'b': result.push_back('\b'); break;
+            case 'f': result.push_back('\f'); break;
+            case 'u':
+                // Multibyte escapes are passed through verbatim; the detailed
+                // result's lexical/ITN fields are plain text in practice.
+                result.push_back('\\');
+                result.push_back('u');
+                break;
+            default: result.push_back(m_data[i]); break;
+            }
+        }
+        return result;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+};
+
+// Lazy zero-copy accessor for the detailed recognition JSON behind
+// PropertyId::SpeechServiceResponse_JsonResult. Full DOM parsing of the
+// N-best payload for every utterance is pure overhead when only a handful of
+// fields are read; this view scans the buffer once, on first access, into an
+// index of borrowed slices (confidence, lexical, ITN, display, per-word
+// timings) and never copies the underlying text. The caller keeps the JSON
+// string alive for the lifetime of the view, exactly as long as it would
+// keep the property value it fetched.
+class DetailedResultView final
+{
+public:
+
+    struct WordTiming
+    {
+        JsonStringView Word;
+        uint64_t Offset = 0;   // in ticks (100 ns), as delivered by the service
+        uint64_t Duration = 0;
+    };
+
+    struct NBestEntry
+    {
+        double Confidence = 0.0;
+        JsonStringView Lexical;
+        JsonStringView Itn;
+        JsonStringView MaskedItn;
+        JsonStringView Display;
+        std::vector<WordTiming> Words;
+    };
+
+    // Borrows 'json'; nothing is parsed until the first accessor call.
+    explicit DetailedResultView(const std::string& json)
+        : m_json(json.c_str()), m_size(json.size())
+    {
+    }
+
+    // Number of N-best alternatives (0 for payloads without an NBest array).
+    size_t Count()
+    {
+        EnsureParsed();
+        return m_entries.size();
+    }
+
+    const NBestEntry& Entry(size_t index)
+    {
+        EnsureParsed();
+        if (index >= m_entries.size())
+        {
+            throw std::out_of_range("N-best index out of range");
+        }
+        return m_entries[index];
+    }
+
+    // The service orders NBest by confidence; the first entry is the best.
+    const NBestEntry& Best()
+    {
+        return Entry(0);
+    }
+
+private:
+
+    // One pass over the buffer, done on first access. Values other than the
+    // indexed fields are skipped structurally without interpretation.
+    void EnsureParsed()
+    {
+        if (m_parsed)
+        {
+            return;
+        }
+        m_parsed = true;
+
+        const char* cursor = m_json;
+        const char* end = m_json + m_size;
+        cursor = SkipWs(cursor, end);
+        if (cursor == end || *cursor != '{')
+        {
+            return;
+        }
+        cursor++;
+
+        // Walks the top-level object looking for the NBest array.
+        while ((cursor = SkipWs(cursor, end)) != end && *cursor != '}')
+        {
+            JsonStringView key;
+            cursor = ParseString(cursor, end, key);
+            cursor = SkipWs(cursor, end);
+            if (cursor == end || *cursor != ':')
+            {
+                return;
+            }
+            cursor = SkipWs(cursor + 1, end);
+
+            if (key == "NBest")
+            {
+                cursor = ParseNBest(cursor, end);
+            }
+            else
+            {
+                cursor = SkipValue(cursor, end);
+            }
+
+            cursor = SkipWs(cursor, end);
+            if (cursor != end && *cursor == ',')
+            {
+                cursor++;
+            }
+        }
+    }
+
+    const char* ParseNBest(const char* cursor, const char* end)
+    {
+        if (cursor == end || *cursor != '[')
+        {
+            return SkipValue(cursor, end);
+        }
+        cursor++;
+        while ((cursor = SkipWs(cursor, end)) != end && *cursor != ']')
+        {
+            NBestEntry entry;
+            cursor = ParseNBestEntry(cursor, end, entry);
+            m_entries.push_back(std::move(entry));
+
+            cursor = SkipWs(cursor, end);
+            if (cursor != end && *cursor == ',')
+            {
+                cursor++;
+            }
+        }
+        return cursor == end ? end : cursor + 1;
+    }
+
+    const char* ParseNBestEntry(const char* cursor, const char* end, NBestEntry& entry)
+    {
+        if (cursor == end || *cursor != '{')
+        {
+            return SkipValue(cursor, end);
+        }
+        cursor++;
+        while ((cursor = SkipWs(cursor, end)) != end && *cursor != '}')
+        {
+            JsonStringView key;
+            cursor = ParseString(cursor, end, key);
+            cursor = SkipWs(cursor, end);
+            if (cursor == end || *cursor != ':')
+            {
+                return end;
+            }
+            cursor = SkipWs(cursor + 1, end);
+
+            if (key == "Confidence")
+            {
+                entry.Confidence = strtod(cursor, nullptr);
+                cursor = SkipValue(cursor, end);
+            }
+            else if (key == "Lexical")
+            {
+                cursor = ParseString(cursor, end, entry.Lexical);
+            }
+            else if (key == "ITN")
+            {
+                cursor = ParseString(cursor, end, entry.Itn);
+            }
+            else if (key == "MaskedITN")
+            {
+                cursor = ParseString(cursor, end, entry.MaskedItn);
+            }
+            else if (key == "Display")
+            {
+                cursor = ParseString(cursor, end, entry.Display);
+            }
+            else if (key == "Words")
+            {
+                cursor = ParseWords(cursor, end, entry.Words);
+            }
+            else
+            {
+                cursor = SkipValue(cursor, end);
+            }
+
+            cursor = SkipWs(cursor, end);
+            if (cursor != end && *cursor == ',')
+            {
+                cursor++;
+            }
+        }
+        return cursor == end ? end : cursor + 1;
+    }
+
+    const char* ParseWords(const char* cursor, const char* end, std::vector<WordTiming>& words)
+    {
+        if (cursor == end || *cursor != '[')
+        {
+            return SkipValue(cursor, end);
+        }
+        cursor++;
+        while ((cursor = SkipWs(cursor, end)) != end && *cursor != ']')
+        {
+            WordTiming word;
+            if (*cursor == '{')
+            {
+                cursor++;
+                while ((cursor = SkipWs(cursor, end)) != end && *cursor != '}')
+                {
+                    JsonStringView key;
+                    cursor = ParseString(cursor, end, key);
+                    cursor = SkipWs(cursor, end);
+                    if (cursor == end || *cursor != ':')
+                    {
+                        return end;
+                    }
+                    cursor = SkipWs(cursor + 1, end);
+
+                    if (key == "Word")
+                    {
+                        cursor = ParseString(cursor, end, word.Word);
+                    }
+                    else if (key == "Offset")
+                    {
+                        word.Offset = strtoull(cursor, nullptr, 10);
+                        cursor = SkipValue(cursor, end);
+                    }
+                    else if (key == "Duration")
+                    {
+                        word.Duration = strtoull(cursor, nullptr, 10);
+                        cursor = SkipValue(cursor, end);
+                    }
+                    else
+                    {
+                        cursor = SkipValue(cursor, end);
+                    }
+
+                    cursor = SkipWs(cursor, end);
+                    if (cursor != end && *cursor == ',')
+                    {
+                        cursor++;
+                    }
+                }
+                cursor = cursor == end ? end : cursor + 1;
+            }
+            else
+            {
+                cursor = SkipValue(cursor, end);
+            }
+            words.push_back(word);
+
+            cursor = SkipWs(cursor, end);
+            if (cursor != end && *cursor == ',')
+            {
+                cursor++;
+            }
+        }
+        return cursor == end ? end : cursor + 1;
+    }
+
+    static const char* SkipWs(const char* cursor, const char* end)
+    {
+        while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r'))
+        {
+            cursor++;
+        }
+        return cursor;
+    }
+
+    // Parses a quoted string into a slice of its raw contents (escapes kept).
+    static const char* ParseString(const char* cursor, const char* end, JsonStringView& value)
+    {
+        if (cursor == end || *cursor != '"')
+        {
+            return SkipValue(cursor, end);
+        }
+        const char* start = ++cursor;
+        while (cursor != end && *cursor != '"')
+        {
+            if (*cursor == '\\' && cursor + 1 != end)
+            {
+                cursor++;
+            }
+            cursor++;
+        }
+        value = JsonStringView(start, (size_t)(cursor - start));
+        return cursor == end ? end : cursor + 1;
+    }
+
+    // Skips one value of any type, tracking nesting; used for every field
+    // the view does not index.
+    static const char* SkipValue(const char* cursor, const char* end)
+    {
+        if (cursor == end)
+        {
+            return end;
+        }
+        if (*cursor == '"')
+        {
+            JsonStringView ignored;
+            return ParseString(cursor, end, ignored);
+        }
+        if (*cursor == '{' || *cursor == '[')
+        {
+            int depth = 0;
+            while (cursor != end)
+            {
+                if (*cursor == '"')
+                {
+                    JsonStringView ignored;
+                    cursor = ParseString(cursor, end, ignored);
+                    continue;
+                }
+                if (*cursor == '{' || *cursor == '[')
+                {
+                    depth++;
+                }
+                else if (*cursor == '}' || *cursor == ']')
+                {
+                    if (--depth == 0)
+                    {
+                        return cursor + 1;
+                    }
+                }
+                cursor++;
+            }
+            return end;
+        }
+        // Number, boolean or null: runs until a structural character.
+        while (cursor != end && *cursor != ',' && *cursor != '}' && *cursor != ']'
+            && *cursor != ' ' && *cursor != '\t' && *cursor != '\n' && *cursor != '\r')
+        {
+            cursor++;
+        }
+        return cursor;
+    }
+
+private:
+    const char* m_json;
+    size_t m_size;
+    bool m_parsed = false;
+    std::vector<NBestEntry> m_entries;
+};
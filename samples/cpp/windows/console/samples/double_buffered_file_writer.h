@@ -0,0 +1,137 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Double-buffered asynchronous file writer for streaming synthesis output.
+// The producer appends into the front buffer while a background thread writes
+// the back buffer to disk; when the front buffer fills, the two are swapped.
+// Network receive thus overlaps with disk I/O, and peak memory stays at two
+// buffers regardless of how long the output runs.
+class DoubleBufferedFileWriter final
+{
+public:
+
+    // Opens 'fileName' for writing. 'bufferSize' is the size of each of the
+    // two buffers, i.e. the granularity of disk writes.
+    explicit DoubleBufferedFileWriter(const std::string& fileName, size_t bufferSize = 256 * 1024)
+        : m_file(fileName, std::ios::binary | std::ios::trunc), m_bufferSize(bufferSize)
+    {
+        if (!m_file)
+        {
+            throw std::invalid_argument("Failed to open the output file for writing.");
+        }
+
+        m_frontBuffer.reserve(bufferSize);
+        m_backBuffer.reserve(bufferSize);
+        m_writer = std::thread(&DoubleBufferedFileWriter::WriteBuffers, this);
+    }
+
+    ~DoubleBufferedFileWriter()
+    {
+        Close();
+    }
+
+    DoubleBufferedFileWriter(const DoubleBufferedFileWriter&) = delete;
+    DoubleBufferedFileWriter& operator=(const DoubleBufferedFileWriter&) = delete;
+
+    // Appends a chunk. Only blocks when both buffers are full, i.e. when the
+    // disk is more than one full buffer behind the network.
+    void Write(const uint8_t* data, size_t size)
+    {
+        while (size > 0)
+        {
+            size_t room = m_bufferSize - m_frontBuffer.size();
+            size_t copied = size < room ? size : room;
+            m_frontBuffer.insert(m_frontBuffer.end(), data, data + copied);
+            data += copied;
+            size -= copied;
+
+            if (m_frontBuffer.size() == m_bufferSize)
+            {
+                SwapBuffers();
+            }
+        }
+    }
+
+    // Flushes everything buffered so far and closes the file. Idempotent.
+    void Close()
+    {
+        if (!m_writer.joinable())
+        {
+            return;
+        }
+
+        if (!m_frontBuffer.empty())
+        {
+            SwapBuffers();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+        m_backBufferReady.notify_one();
+        m_writer.join();
+        m_file.close();
+    }
+
+private:
+
+    // Hands the filled front buffer to the writer thread, waiting for it to
+    // finish the previous one first.
+    void SwapBuffers()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_backBufferIdle.wait(lock, [this] { return !m_backBufferFull; });
+        m_frontBuffer.swap(m_backBuffer);
+        m_backBufferFull = true;
+        lock.unlock();
+        m_backBufferReady.notify_one();
+    }
+
+    void WriteBuffers()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_backBufferReady.wait(lock, [this] { return m_backBufferFull || m_shutdown; });
+            if (!m_backBufferFull && m_shutdown)
+            {
+                return;
+            }
+
+            // The disk write happens outside the lock, so the producer keeps
+            // filling the front buffer meanwhile.
+            lock.unlock();
+            m_file.write(reinterpret_cast<const char*>(m_backBuffer.data()), m_backBuffer.size());
+            lock.lock();
+
+            m_backBuffer.clear();
+            m_backBufferFull = false;
+            m_backBufferIdle.notify_one();
+        }
+    }
+
+private:
+    std::ofstream m_file;
+    size_t m_bufferSize;
+    std::vector<uint8_t> m_frontBuffer;
+    std::vector<uint8_t> m_backBuffer;
+    std::mutex m_mutex;
+    std::condition_variable m_backBufferReady;
+    std::condition_variable m_backBufferIdle;
+    bool m_backBufferFull = false;
+    bool m_shutdown = false;
+    std::thread m_writer;
+};
@@ -0,0 +1,45 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <speechapi_cxx.h>
+
+// Process-wide cache of keyword recognition models. Loading a .table file is
+// expensive enough to show up in session startup profiles when keyword
+// sessions are restarted frequently; the cache loads each file once and hands
+// the same shared model to every subsequent session. Models are immutable once
+// loaded, so sharing one instance across recognizers is safe.
+class KeywordModelCache final
+{
+public:
+
+    // Returns the model for 'modelFileName', loading it on the first request
+    // and serving the cached instance on every later one.
+    static std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognitionModel> Get(const std::string& modelFileName)
+    {
+        static KeywordModelCache cache;
+
+        std::lock_guard<std::mutex> lock(cache.m_mutex);
+        auto it = cache.m_models.find(modelFileName);
+        if (it != cache.m_models.end())
+        {
+            return it->second;
+        }
+
+        auto model = Microsoft::CognitiveServices::Speech::KeywordRecognitionModel::FromFile(modelFileName);
+        cache.m_models[modelFileName] = model;
+        return model;
+    }
+
+private:
+    KeywordModelCache() = default;
+
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognitionModel>> m_models;
+};
@@ -0,0 +1,141 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <vector>
+
+// Measures end-to-end recognition latency for stream-fed sessions. The feeder
+// reports when each audio byte is submitted to the SDK; event handlers report
+// the service-side position of each result via Offset()/Duration(), which are
+// expressed in 100-nanosecond ticks from the start of the audio. Correlating
+// the two yields, per utterance:
+//   - first-hypothesis latency: time from submitting the byte at the utterance
+//     start to the arrival of the first Recognizing event for it, and
+//   - final-result latency: time from submitting the last byte of the utterance
+//     to the arrival of its Recognized event.
+// At session end PrintSummary() prints p50/p95/p99 of both distributions.
+class LatencyRecorder final
+{
+public:
+
+    // Resets the recorder for a new session. 'avgBytesPerSec' is the byte rate
+    // of the audio being streamed, used to map result ticks to byte positions.
+    void Start(uint32_t avgBytesPerSec)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_avgBytesPerSec = avgBytesPerSec;
+        m_submissions.clear();
+        m_hypothesisOffsets.clear();
+        m_firstHypothesisLatencies.clear();
+        m_finalResultLatencies.clear();
+    }
+
+    // Called by the feeder after each write to the SDK, with the cumulative
+    // number of audio bytes submitted so far.
+    void OnAudioSubmitted(uint64_t totalBytesSubmitted)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_submissions.push_back({ totalBytesSubmitted, std::chrono::steady_clock::now() });
+    }
+
+    // Called from the Recognizing handler. Only the first hypothesis for each
+    // utterance (identified by its start offset) contributes a sample.
+    void OnHypothesis(uint64_t offsetTicks)
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_hypothesisOffsets.insert(offsetTicks).second)
+        {
+            return;
+        }
+        RecordLatency(m_firstHypothesisLatencies, offsetTicks, now);
+    }
+
+    // Called from the Recognized handler with the final result's position.
+    // Latency is measured from the submission of the utterance's last byte.
+    void OnFinalResult(uint64_t offsetTicks, uint64_t durationTicks)
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        RecordLatency(m_finalResultLatencies, offsetTicks + durationTicks, now);
+    }
+
+    // Prints p50/p95/p99 of both latency distributions.
+    void PrintSummary()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PrintPercentiles("First-hypothesis latency (ms)", m_firstHypothesisLatencies);
+        PrintPercentiles("Final-result latency (ms)", m_finalResultLatencies);
+    }
+
+    // Prints p50/p95/p99 of an arbitrary sample set (values in ms unless the
+    // name says otherwise). Shared by the other instrumented samples.
+    static void PrintPercentiles(const char* name, std::vector<double> values)
+    {
+        if (values.empty())
+        {
+            std::cout << name << ": no samples." << std::endl;
+            return;
+        }
+        std::sort(values.begin(), values.end());
+        std::cout << name << " (n=" << values.size() << "):"
+            << " p50=" << Percentile(values, 50)
+            << " p95=" << Percentile(values, 95)
+            << " p99=" << Percentile(values, 99) << std::endl;
+    }
+
+    // 'sorted' must be sorted ascending and non-empty.
+    static double Percentile(const std::vector<double>& sorted, int p)
+    {
+        size_t index = (size_t)((sorted.size() - 1) * p / 100.0 + 0.5);
+        return sorted[index];
+    }
+
+private:
+    struct Submission
+    {
+        uint64_t bytes;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    // Converts a result position in ticks to a byte position, finds when that
+    // byte was submitted, and appends the elapsed time to 'latencies'.
+    // Positions beyond what has been submitted so far are clock skew between
+    // the service timeline and ours; they are attributed to the last write.
+    void RecordLatency(std::vector<double>& latencies, uint64_t positionTicks, std::chrono::steady_clock::time_point eventTime)
+    {
+        if (m_submissions.empty() || m_avgBytesPerSec == 0)
+        {
+            return;
+        }
+
+        // Offset() and Duration() are in 100-nanosecond ticks.
+        uint64_t positionBytes = (uint64_t)(positionTicks / 10000000.0 * m_avgBytesPerSec);
+
+        auto it = std::lower_bound(m_submissions.begin(), m_submissions.end(), positionBytes,
+            [](const Submission& s, uint64_t bytes) { return s.bytes < bytes; });
+        if (it == m_submissions.end())
+        {
+            it = m_submissions.end() - 1;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(eventTime - it->time).count();
+        latencies.push_back(ms);
+    }
+
+private:
+    std::mutex m_mutex;
+    uint32_t m_avgBytesPerSec = 0;
+    std::vector<Submission> m_submissions;
+    std::set<uint64_t> m_hypothesisOffsets;
+    std::vector<double> m_firstHypothesisLatencies;
+    std::vector<double> m_finalResultLatencies;
+};
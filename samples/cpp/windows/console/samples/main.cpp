@@ -5,9 +5,18 @@
 #include "stdafx.h"
 #include <iostream>
 #include <string>
+#include <vector>
+#include "metrics_writer.h"
 
 using namespace std;
 
+// Scripted scenario runner (scenario_runner.cpp); takes over when the binary
+// is invoked with command-line arguments.
+extern int RunScenarioFromCommandLine(const vector<string>& args);
+
+// Offline feed-path benchmark suite (benchmarks.cpp), run via 'samples bench'.
+extern int RunBenchmarks();
+
 extern void SpeechRecognitionWithMicrophone();
 extern void SpeechRecognitionWithLanguageAndUsingDetailedOutputFormat();
 extern void SpeechContinuousRecognitionWithFile();
@@ -16,13 +25,21 @@ extern void SpeechContinuousRecognitionWithPullStream();
 extern void SpeechContinuousRecognitionWithPushStream();
 extern void KeywordTriggeredSpeechRecognitionWithMicrophone();
 extern void PronunciationAssessmentWithMicrophone();
+extern void PronunciationAssessmentBatch();
+extern void SpeechBatchRecognitionFromDirectory();
+extern void SpeechRecognitionMultiplexerDemo();
 
 extern void IntentRecognitionWithMicrophone();
 extern void IntentRecognitionWithLanguage();
 extern void IntentContinuousRecognitionWithFile();
+extern void IntentRecognitionVoiceCommandLoop();
+extern void IntentRecognitionBatch();
 
 extern void TranslationWithMicrophone();
 extern void TranslationContinuousRecognition();
+extern void TranslationContinuousRecognitionFromCompressedFile();
+extern void TranslationMultiTargetContinuousRecognition();
+extern void TranslationWithSpeechSynthesis();
 
 extern void SpeechSynthesisToSpeaker();
 extern void SpeechSynthesisWithLanguage();
@@ -32,6 +49,10 @@ extern void SpeechSynthesisToMp3File();
 extern void SpeechSynthesisToPullAudioOutputStream();
 extern void SpeechSynthesisToPushAudioOutputStream();
 extern void SpeechSynthesisToResult();
+extern void SpeechSynthesisToResultWithCache();
+extern void SpeechSynthesisPipelined();
+extern void SpeechSynthesisMultiVoiceFanOut();
+extern void SpeechSynthesisBatchSsmlRender();
 extern void SpeechSynthesisToAudioDataStream();
 extern void SpeechSynthesisEvents();
 extern void SpeechSynthesisWordBoundaryEvent();
@@ -44,6 +65,8 @@ extern void SpeakerVerificationWithMicrophone();
 extern void SpeakerVerificationWithPushStream();
 extern void SpeakerIdentificationWithPullStream();
 extern void SpeakerIdentificationWithMicrophone();
+extern void SpeakerBulkEnrollment();
+extern void SpeakerIdentificationBatch();
 
 void SpeechSamples()
 {
@@ -59,6 +82,9 @@ void SpeechSamples()
         cout << "6.) Speech recognition using push stream input.\n";
         cout << "7.) Speech recognition using microphone with a keyword trigger.\n";
         cout << "8.) Pronunciation assessment using microphone input.\n";
+        cout << "9.) Parallel batch recognition over a directory of wav files.\n";
+        cout << "A.) Multiplexed single-shot recognition load generator.\n";
+        cout << "B.) Parallel batch pronunciation assessment from a manifest.\n";
         cout << "\nChoice (0 for MAIN MENU): ";
         cout.flush();
 
@@ -91,6 +117,17 @@ void SpeechSamples()
         case '8':
             PronunciationAssessmentWithMicrophone();
             break;
+        case '9':
+            SpeechBatchRecognitionFromDirectory();
+            break;
+        case 'A':
+        case 'a':
+            SpeechRecognitionMultiplexerDemo();
+            break;
+        case 'B':
+        case 'b':
+            PronunciationAssessmentBatch();
+            break;
         case '0':
             break;
         }
@@ -106,6 +143,8 @@ void IntentSamples()
         cout << "1.) Intent recognition with microphone input.\n";
         cout << "2.) Intent recognition in the specified language.\n";
         cout << "3.) Intent continuous recognition with file input.\n";
+        cout << "4.) Voice-command loop with a persistent intent recognizer.\n";
+        cout << "5.) Parallel intent recognition batch over a file list.\n";
         cout << "\nChoice (0 for MAIN MENU): ";
         cout.flush();
 
@@ -123,6 +162,12 @@ void IntentSamples()
         case '3':
             IntentContinuousRecognitionWithFile();
             break;
+        case '4':
+            IntentRecognitionVoiceCommandLoop();
+            break;
+        case '5':
+            IntentRecognitionBatch();
+            break;
         case '0':
             break;
         }
@@ -137,6 +182,9 @@ void TranslationSamples()
         cout << "\nTRANSLATION SAMPLES:\n";
         cout << "1.) Translation with microphone input.\n";
         cout << "2.) Translation continuous recognition.\n";
+        cout << "3.) Multi-target translation with per-language result sinks.\n";
+        cout << "4.) Speech-to-speech translation with pooled audio egress.\n";
+        cout << "5.) Translation streaming a compressed audio file (MP3/Opus/FLAC).\n";
         cout << "\nChoice (0 for MAIN MENU): ";
         cout.flush();
 
@@ -151,6 +199,15 @@ void TranslationSamples()
         case '2':
             TranslationContinuousRecognition();
             break;
+        case '3':
+            TranslationMultiTargetContinuousRecognition();
+            break;
+        case '4':
+            TranslationWithSpeechSynthesis();
+            break;
+        case '5':
+            TranslationContinuousRecognitionFromCompressedFile();
+            break;
         case '0':
             break;
         }
@@ -175,6 +232,10 @@ void SpeechSynthesisSamples()
         cout << "A.) Speech synthesis events.\n";
         cout << "B.) Speech synthesis word boundary event.\n";
         cout << "C.) Speech synthesis with source language auto detection\n";
+        cout << "D.) Speech synthesis to result with a persistent prompt cache.\n";
+        cout << "E.) Pipelined speech synthesis overlapping requests with playback.\n";
+        cout << "F.) Concurrent multi-voice synthesis fan-out.\n";
+        cout << "G.) Batch SSML rendering with parallel workers.\n";
         cout << "\nChoice (0 for MAIN MENU): ";
         cout.flush();
 
@@ -222,6 +283,22 @@ void SpeechSynthesisSamples()
         case 'c':
             SpeechSynthesisWithSourceLanguageAutoDetection();
             break;
+        case 'D':
+        case 'd':
+            SpeechSynthesisToResultWithCache();
+            break;
+        case 'E':
+        case 'e':
+            SpeechSynthesisPipelined();
+            break;
+        case 'F':
+        case 'f':
+            SpeechSynthesisMultiVoiceFanOut();
+            break;
+        case 'G':
+        case 'g':
+            SpeechSynthesisBatchSsmlRender();
+            break;
         case '0':
             break;
         }
@@ -266,6 +343,8 @@ void SpeakerRecognitionSamples()
         cout << "2.) Speaker verification with push audio stream input.\n";
         cout << "3.) Speaker identification with pull audio stream input.\n";
         cout << "4.) Speaker identification with microphone input.\n";
+        cout << "5.) Bulk speaker enrollment with concurrent workers.\n";
+        cout << "6.) Batch speaker identification with a shared model and recognizer.\n";
         cout << "\nChoice (0 for MAIN MENU): ";
         cout.flush();
 
@@ -290,6 +369,14 @@ void SpeakerRecognitionSamples()
             SpeakerIdentificationWithMicrophone();
             break;
 
+        case '5':
+            SpeakerBulkEnrollment();
+            break;
+
+        case '6':
+            SpeakerIdentificationBatch();
+            break;
+
         case '0':
             break;
         }
@@ -302,6 +389,44 @@ int wmain(int argc, wchar_t **argv)
 int main(int argc, char **argv)
 #endif
 {
+    // With arguments the binary runs scripted scenarios instead of the menu,
+    // e.g.: samples run --scenario push-stream --sessions 50 --iterations 10
+    if (argc > 1)
+    {
+        vector<string> args;
+        for (int i = 1; i < argc; i++)
+        {
+#ifdef _WIN32
+            wstring wide(argv[i]);
+            args.push_back(string(wide.begin(), wide.end()));
+#else
+            args.push_back(argv[i]);
+#endif
+        }
+
+        // '--metrics jsonl' switches the instrumented handlers to structured
+        // JSON-lines output; it composes with any of the commands below.
+        for (size_t i = 0; i + 1 < args.size(); i++)
+        {
+            if (args[i] == "--metrics" && args[i + 1] == "jsonl")
+            {
+                MetricsWriter::Shared().EnableJsonLines();
+                args.erase(args.begin() + i, args.begin() + i + 2);
+                break;
+            }
+        }
+        if (args.empty())
+        {
+            cout << "No command given.\n";
+            return 1;
+        }
+        if (args[0] == "bench")
+        {
+            return RunBenchmarks();
+        }
+        return RunScenarioFromCommandLine(args);
+    }
+
     string input;
     do
     {
@@ -0,0 +1,310 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Maps a wav file into memory (MapViewOfFile on Windows, mmap on POSIX) and exposes
+// the data chunk as a zero-copy span. Unlike WavFileReader, Read() does not go through
+// a stream buffer: it is a pointer bump plus a single memcpy into the caller's buffer,
+// which avoids double buffering when many file-driven sessions run concurrently.
+class MemoryMappedWavFileReader final
+{
+public:
+
+    // Constructor that maps the specified file and locates its data chunk.
+    MemoryMappedWavFileReader(const std::string& audioFileName)
+    {
+        if (audioFileName.empty())
+        {
+            throw std::invalid_argument("Audio filename is empty");
+        }
+
+        MapFile(audioFileName);
+
+        try
+        {
+            // Get audio format and data chunk location from the file header.
+            GetFormatFromWavData();
+        }
+        catch (...)
+        {
+            UnmapFile();
+            throw;
+        }
+    }
+
+    ~MemoryMappedWavFileReader()
+    {
+        UnmapFile();
+    }
+
+    MemoryMappedWavFileReader(const MemoryMappedWavFileReader&) = delete;
+    MemoryMappedWavFileReader& operator=(const MemoryMappedWavFileReader&) = delete;
+
+    // Copies up to 'size' bytes of audio data into 'dataBuffer'.
+    // Returns the number of bytes copied, or 0 when the data chunk is exhausted.
+    int Read(uint8_t* dataBuffer, uint32_t size)
+    {
+        if (m_position >= m_dataSize)
+        {
+            // returns 0 to indicate that the stream reaches end.
+            return 0;
+        }
+
+        size_t toCopy = m_dataSize - m_position;
+        if (toCopy > size)
+        {
+            toCopy = size;
+        }
+
+        memcpy(dataBuffer, m_data + m_position, toCopy);
+        m_position += toCopy;
+        return (int)toCopy;
+    }
+
+    // Gets a zero-copy pointer to the audio data chunk.
+    const uint8_t* Data() const
+    {
+        return m_data;
+    }
+
+    // Gets the size of the audio data chunk in bytes.
+    size_t DataSize() const
+    {
+        return m_dataSize;
+    }
+
+    void Close()
+    {
+        UnmapFile();
+        m_data = nullptr;
+        m_dataSize = 0;
+        m_position = 0;
+    }
+
+private:
+    // Defines common constants for WAV format.
+    static constexpr uint16_t tagBufferSize = 4;
+    static constexpr uint16_t chunkTypeBufferSize = 4;
+    static constexpr uint16_t chunkSizeBufferSize = 4;
+
+    void MapFile(const std::string& audioFileName)
+    {
+#if defined(_WIN32)
+        m_fileHandle = CreateFileA(audioFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_fileHandle == INVALID_HANDLE_VALUE)
+        {
+            throw std::invalid_argument("Failed to open the specified audio file.");
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(m_fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+            throw std::runtime_error("Failed to get the size of the audio file.");
+        }
+        m_fileSize = (size_t)fileSize.QuadPart;
+
+        m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mappingHandle == nullptr)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+            throw std::runtime_error("Failed to create a file mapping for the audio file.");
+        }
+
+        m_fileData = (const uint8_t*)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (m_fileData == nullptr)
+        {
+            CloseHandle(m_mappingHandle);
+            CloseHandle(m_fileHandle);
+            m_mappingHandle = nullptr;
+            m_fileHandle = INVALID_HANDLE_VALUE;
+            throw std::runtime_error("Failed to map a view of the audio file.");
+        }
+#else
+        m_fileDescriptor = open(audioFileName.c_str(), O_RDONLY);
+        if (m_fileDescriptor < 0)
+        {
+            throw std::invalid_argument("Failed to open the specified audio file.");
+        }
+
+        struct stat fileStat;
+        if (fstat(m_fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(m_fileDescriptor);
+            m_fileDescriptor = -1;
+            throw std::runtime_error("Failed to get the size of the audio file.");
+        }
+        m_fileSize = (size_t)fileStat.st_size;
+
+        void* mapped = mmap(nullptr, m_fileSize, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+        if (mapped == MAP_FAILED)
+        {
+            close(m_fileDescriptor);
+            m_fileDescriptor = -1;
+            throw std::runtime_error("Failed to map the audio file into memory.");
+        }
+        m_fileData = (const uint8_t*)mapped;
+#endif
+    }
+
+    void UnmapFile()
+    {
+#if defined(_WIN32)
+        if (m_fileData != nullptr)
+        {
+            UnmapViewOfFile(m_fileData);
+            m_fileData = nullptr;
+        }
+        if (m_mappingHandle != nullptr)
+        {
+            CloseHandle(m_mappingHandle);
+            m_mappingHandle = nullptr;
+        }
+        if (m_fileHandle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_fileData != nullptr)
+        {
+            munmap((void*)m_fileData, m_fileSize);
+            m_fileData = nullptr;
+        }
+        if (m_fileDescriptor >= 0)
+        {
+            close(m_fileDescriptor);
+            m_fileDescriptor = -1;
+        }
+#endif
+    }
+
+    // Get format data and the data chunk location from the mapped wav file.
+    void GetFormatFromWavData()
+    {
+        size_t offset = 0;
+
+        // Checks the RIFF tag
+        if (m_fileSize < tagBufferSize + chunkSizeBufferSize + chunkTypeBufferSize
+            || memcmp(m_fileData, "RIFF", tagBufferSize) != 0)
+        {
+            throw std::runtime_error("Invalid file header, tag 'RIFF' is expected.");
+        }
+
+        // The next is the RIFF chunk size, ignore now.
+        offset = tagBufferSize + chunkSizeBufferSize;
+
+        // Checks the 'WAVE' tag in the wave header.
+        if (memcmp(m_fileData + offset, "WAVE", chunkTypeBufferSize) != 0)
+        {
+            throw std::runtime_error("Invalid file header, tag 'WAVE' is expected.");
+        }
+        offset += chunkTypeBufferSize;
+
+        bool foundDataChunk = false;
+        while (offset + chunkTypeBufferSize + chunkSizeBufferSize <= m_fileSize)
+        {
+            const uint8_t* chunkType = m_fileData + offset;
+            uint32_t chunkSize = ReadChunkSize(offset + chunkTypeBufferSize);
+            offset += chunkTypeBufferSize + chunkSizeBufferSize;
+
+            if (memcmp(chunkType, "fmt ", chunkTypeBufferSize) == 0)
+            {
+                if (chunkSize < sizeof(m_formatHeader) || offset + chunkSize > m_fileSize)
+                {
+                    throw std::runtime_error("Invalid format chunk in audio file.");
+                }
+
+                // Reads format data.
+                memcpy(&m_formatHeader, m_fileData + offset, sizeof(m_formatHeader));
+
+                // Skips the rest of format data.
+                offset += chunkSize;
+            }
+            else if (memcmp(chunkType, "data", chunkTypeBufferSize) == 0)
+            {
+                foundDataChunk = true;
+
+                // Clamps the data chunk to the mapped size, in case the header overstates it.
+                m_data = m_fileData + offset;
+                m_dataSize = chunkSize;
+                if (offset + m_dataSize > m_fileSize)
+                {
+                    m_dataSize = m_fileSize - offset;
+                }
+                break;
+            }
+            else
+            {
+                offset += chunkSize;
+            }
+        }
+
+        if (!foundDataChunk)
+        {
+            throw std::runtime_error("Did not find data chunk.");
+        }
+        if (m_dataSize == 0)
+        {
+            throw std::runtime_error("Unexpected end of file, before any audio data can be read.");
+        }
+    }
+
+    uint32_t ReadChunkSize(size_t offset) const
+    {
+        const uint8_t* chunkSizeBuffer = m_fileData + offset;
+
+        // chunk size is little endian
+        return ((uint32_t)chunkSizeBuffer[3] << 24) |
+            ((uint32_t)chunkSizeBuffer[2] << 16) |
+            ((uint32_t)chunkSizeBuffer[1] << 8) |
+            (uint32_t)chunkSizeBuffer[0];
+    }
+
+    // The format structure expected in wav files.
+    struct WAVEFORMAT
+    {
+        uint16_t FormatTag;        // format type.
+        uint16_t Channels;         // number of channels (i.e. mono, stereo...).
+        uint32_t SamplesPerSec;    // sample rate.
+        uint32_t AvgBytesPerSec;   // for buffer estimation.
+        uint16_t BlockAlign;       // block size of data.
+        uint16_t BitsPerSample;    // Number of bits per sample of mono data.
+    } m_formatHeader = {};
+    static_assert(sizeof(m_formatHeader) == 16, "unexpected size of m_formatHeader");
+
+private:
+#if defined(_WIN32)
+    HANDLE m_fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE m_mappingHandle = nullptr;
+#else
+    int m_fileDescriptor = -1;
+#endif
+    const uint8_t* m_fileData = nullptr;
+    size_t m_fileSize = 0;
+    const uint8_t* m_data = nullptr;
+    size_t m_dataSize = 0;
+    size_t m_position = 0;
+};
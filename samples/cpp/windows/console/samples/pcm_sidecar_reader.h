@@ -0,0 +1,293 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "resampling_wav_reader.h"
+#include "wav_file_reader.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Serves a wav file as canonical 16 kHz/16-bit/mono PCM through a sidecar
+// cache: the first read of a file parses, downmixes, and (when needed)
+// resamples it once, writing the converted samples to '<file>.pcm' next to
+// the source; every later run memory-maps that sidecar directly, so repeated
+// passes over the same corpus — the regression-run case — skip header parsing
+// and conversion entirely. A sidecar older than its source is rebuilt, and
+// the conversion goes through a temporary file plus rename so an interrupted
+// run never leaves a truncated sidecar behind.
+class PcmSidecarReader final
+{
+public:
+
+    // Constructor that opens (building it first if needed) the sidecar for the
+    // specified wav file and maps it into memory.
+    PcmSidecarReader(const std::string& audioFileName, uint32_t outputSampleRate = 16000)
+    {
+        if (audioFileName.empty())
+        {
+            throw std::invalid_argument("Audio filename is empty");
+        }
+
+        std::string sidecarPath = audioFileName + ".pcm";
+        if (!SidecarIsCurrent(audioFileName, sidecarPath))
+        {
+            BuildSidecar(audioFileName, sidecarPath, outputSampleRate);
+        }
+
+        MapFile(sidecarPath);
+    }
+
+    ~PcmSidecarReader()
+    {
+        UnmapFile();
+    }
+
+    PcmSidecarReader(const PcmSidecarReader&) = delete;
+    PcmSidecarReader& operator=(const PcmSidecarReader&) = delete;
+
+    // Copies up to 'size' bytes of 16 kHz mono int16 audio into 'dataBuffer'.
+    // Returns the number of bytes copied, or 0 when the stream reaches end.
+    int Read(uint8_t* dataBuffer, uint32_t size)
+    {
+        if (m_position >= m_dataSize)
+        {
+            // returns 0 to indicate that the stream reaches end.
+            return 0;
+        }
+
+        size_t toCopy = m_dataSize - m_position;
+        if (toCopy > size)
+        {
+            toCopy = size;
+        }
+
+        memcpy(dataBuffer, m_data + m_position, toCopy);
+        m_position += toCopy;
+        return (int)toCopy;
+    }
+
+    // Gets a zero-copy pointer to the converted samples.
+    const uint8_t* Data() const
+    {
+        return m_data;
+    }
+
+    // Gets the size of the converted samples in bytes.
+    size_t DataSize() const
+    {
+        return m_dataSize;
+    }
+
+    void Close()
+    {
+        UnmapFile();
+        m_position = 0;
+    }
+
+private:
+    // Returns true when the sidecar exists and is not older than its source,
+    // so a re-exported wav invalidates its cached conversion automatically.
+    static bool SidecarIsCurrent(const std::string& audioFileName, const std::string& sidecarPath)
+    {
+#if defined(_WIN32)
+        WIN32_FILE_ATTRIBUTE_DATA source;
+        WIN32_FILE_ATTRIBUTE_DATA sidecar;
+        if (!GetFileAttributesExA(sidecarPath.c_str(), GetFileExInfoStandard, &sidecar) ||
+            !GetFileAttributesExA(audioFileName.c_str(), GetFileExInfoStandard, &source))
+        {
+            return false;
+        }
+        return CompareFileTime(&sidecar.ftLastWriteTime, &source.ftLastWriteTime) >= 0;
+#else
+        struct stat source;
+        struct stat sidecar;
+        if (stat(sidecarPath.c_str(), &sidecar) != 0 || stat(audioFileName.c_str(), &source) != 0)
+        {
+            return false;
+        }
+#if defined(st_mtime)
+        // st_mtime is a macro onto st_mtim on POSIX.1-2008 systems; comparing
+        // the full timespec avoids missing rewrites within the same second.
+        if (sidecar.st_mtim.tv_sec != source.st_mtim.tv_sec)
+        {
+            return sidecar.st_mtim.tv_sec > source.st_mtim.tv_sec;
+        }
+        return sidecar.st_mtim.tv_nsec >= source.st_mtim.tv_nsec;
+#else
+        return sidecar.st_mtime >= source.st_mtime;
+#endif
+#endif
+    }
+
+    // Converts the wav file to canonical PCM and publishes it at 'sidecarPath'.
+    // Native-rate files go through ResamplingWavReader; files already at the
+    // target rate only need WavFileReader's parse/downmix pass.
+    static void BuildSidecar(const std::string& audioFileName, const std::string& sidecarPath,
+        uint32_t outputSampleRate)
+    {
+        std::string temporaryPath = sidecarPath + ".tmp";
+        {
+            std::ofstream sidecar(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!sidecar)
+            {
+                throw std::runtime_error("Failed to create the sidecar cache file.");
+            }
+
+            std::vector<uint8_t> chunk(64 * 1024);
+            int bytesRead;
+
+            WavFileReader reader(audioFileName);
+            if (reader.GetSamplesPerSec() == outputSampleRate)
+            {
+                while ((bytesRead = reader.Read(chunk.data(), (uint32_t)chunk.size())) > 0)
+                {
+                    sidecar.write((const char*)chunk.data(), bytesRead);
+                }
+            }
+            else
+            {
+                reader.Close();
+                ResamplingWavReader resampler(audioFileName, outputSampleRate);
+                while ((bytesRead = resampler.Read(chunk.data(), (uint32_t)chunk.size())) > 0)
+                {
+                    sidecar.write((const char*)chunk.data(), bytesRead);
+                }
+                resampler.Close();
+            }
+
+            if (!sidecar)
+            {
+                throw std::runtime_error("Failed to write the sidecar cache file.");
+            }
+        }
+
+        // Publishes the finished conversion atomically.
+#if defined(_WIN32)
+        if (!MoveFileExA(temporaryPath.c_str(), sidecarPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+#else
+        if (rename(temporaryPath.c_str(), sidecarPath.c_str()) != 0)
+#endif
+        {
+            remove(temporaryPath.c_str());
+            throw std::runtime_error("Failed to publish the sidecar cache file.");
+        }
+    }
+
+    void MapFile(const std::string& sidecarPath)
+    {
+#if defined(_WIN32)
+        m_fileHandle = CreateFileA(sidecarPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_fileHandle == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Failed to open the sidecar cache file.");
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(m_fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+            throw std::runtime_error("Failed to get the size of the sidecar cache file.");
+        }
+        m_dataSize = (size_t)fileSize.QuadPart;
+
+        m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mappingHandle == nullptr)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+            throw std::runtime_error("Failed to create a file mapping for the sidecar cache file.");
+        }
+
+        m_data = (const uint8_t*)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (m_data == nullptr)
+        {
+            CloseHandle(m_mappingHandle);
+            CloseHandle(m_fileHandle);
+            m_mappingHandle = nullptr;
+            m_fileHandle = INVALID_HANDLE_VALUE;
+            throw std::runtime_error("Failed to map a view of the sidecar cache file.");
+        }
+#else
+        int fileDescriptor = open(sidecarPath.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            throw std::runtime_error("Failed to open the sidecar cache file.");
+        }
+
+        struct stat fileStat;
+        if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(fileDescriptor);
+            throw std::runtime_error("Failed to get the size of the sidecar cache file.");
+        }
+        m_dataSize = (size_t)fileStat.st_size;
+
+        void* mapped = mmap(nullptr, m_dataSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        close(fileDescriptor); // the mapping keeps its own reference.
+        if (mapped == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map the sidecar cache file into memory.");
+        }
+        m_data = (const uint8_t*)mapped;
+#endif
+    }
+
+    void UnmapFile()
+    {
+#if defined(_WIN32)
+        if (m_data != nullptr)
+        {
+            UnmapViewOfFile(m_data);
+            m_data = nullptr;
+        }
+        if (m_mappingHandle != nullptr)
+        {
+            CloseHandle(m_mappingHandle);
+            m_mappingHandle = nullptr;
+        }
+        if (m_fileHandle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_data != nullptr)
+        {
+            munmap((void*)m_data, m_dataSize);
+            m_data = nullptr;
+        }
+#endif
+        m_dataSize = 0;
+    }
+
+private:
+#if defined(_WIN32)
+    HANDLE m_fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE m_mappingHandle = nullptr;
+#endif
+    const uint8_t* m_data = nullptr;
+    size_t m_dataSize = 0;
+    size_t m_position = 0;
+};
@@ -0,0 +1,151 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "wav_file_reader.h"
+
+// Wraps WavFileReader with a background thread that keeps a small pool of buffers
+// filled ahead of the consumer. Read() hands out data from already completed buffers
+// without blocking on disk, and only waits when the producer is genuinely behind.
+// This keeps the SDK's audio pump thread from stalling on file I/O latency spikes,
+// e.g. when audio lives on network-mounted storage.
+class PrefetchingWavFileReader final
+{
+public:
+
+    // Constructor that creates an input stream from a file and starts prefetching.
+    // 'bufferSize' is the size of each prefetch buffer in bytes, and 'bufferCount'
+    // is how many buffers the background thread keeps filled ahead of the consumer.
+    PrefetchingWavFileReader(const std::string& audioFileName, size_t bufferSize = 32 * 1024, size_t bufferCount = 4)
+        // The background thread scans the file front to back, so open it in
+        // sequential-read mode with a large block buffer.
+        : m_reader(audioFileName, 1024 * 1024), m_bufferSize(bufferSize), m_bufferCount(bufferCount)
+    {
+        if (bufferSize == 0 || bufferCount == 0)
+        {
+            throw std::invalid_argument("Buffer size and buffer count must not be zero.");
+        }
+
+        m_producer = std::thread(&PrefetchingWavFileReader::ProduceBuffers, this);
+    }
+
+    ~PrefetchingWavFileReader()
+    {
+        Close();
+    }
+
+    PrefetchingWavFileReader(const PrefetchingWavFileReader&) = delete;
+    PrefetchingWavFileReader& operator=(const PrefetchingWavFileReader&) = delete;
+
+    // Copies up to 'size' bytes of audio data into 'dataBuffer' from the prefetched buffers.
+    // Waits only when no completed buffer is available yet.
+    // Returns the number of bytes copied, or 0 when the stream reaches end or is closed.
+    int Read(uint8_t* dataBuffer, uint32_t size)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Waits until a completed buffer is available, the producer is done, or the reader is closed.
+        m_bufferReady.wait(lock, [this] { return !m_buffers.empty() || m_endOfFile || m_closed; });
+
+        if (m_buffers.empty())
+        {
+            // returns 0 to indicate that the stream reaches end or is closed.
+            return 0;
+        }
+
+        std::vector<uint8_t>& front = m_buffers.front();
+        size_t available = front.size() - m_frontOffset;
+        size_t toCopy = available < size ? available : size;
+
+        memcpy(dataBuffer, front.data() + m_frontOffset, toCopy);
+        m_frontOffset += toCopy;
+
+        if (m_frontOffset == front.size())
+        {
+            m_buffers.pop_front();
+            m_frontOffset = 0;
+
+            // A slot freed up, let the producer refill it.
+            m_bufferFree.notify_one();
+        }
+
+        return (int)toCopy;
+    }
+
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed)
+            {
+                return;
+            }
+            m_closed = true;
+        }
+        m_bufferReady.notify_all();
+        m_bufferFree.notify_all();
+
+        if (m_producer.joinable())
+        {
+            m_producer.join();
+        }
+        m_reader.Close();
+    }
+
+private:
+    // Runs on the background thread: keeps up to m_bufferCount buffers filled.
+    void ProduceBuffers()
+    {
+        for (;;)
+        {
+            std::vector<uint8_t> buffer(m_bufferSize);
+            int bytesRead = m_reader.Read(buffer.data(), (uint32_t)buffer.size());
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (bytesRead <= 0)
+            {
+                m_endOfFile = true;
+                m_bufferReady.notify_all();
+                return;
+            }
+
+            buffer.resize(bytesRead);
+
+            // Waits for a free slot when the consumer is behind.
+            m_bufferFree.wait(lock, [this] { return m_buffers.size() < m_bufferCount || m_closed; });
+            if (m_closed)
+            {
+                return;
+            }
+
+            m_buffers.push_back(std::move(buffer));
+            m_bufferReady.notify_one();
+        }
+    }
+
+private:
+    WavFileReader m_reader;
+    size_t m_bufferSize;
+    size_t m_bufferCount;
+
+    std::mutex m_mutex;
+    std::condition_variable m_bufferReady;
+    std::condition_variable m_bufferFree;
+    std::deque<std::vector<uint8_t>> m_buffers;
+    size_t m_frontOffset = 0;
+    bool m_endOfFile = false;
+    bool m_closed = false;
+
+    std::thread m_producer;
+};
@@ -0,0 +1,175 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#include "stdafx.h"
+
+#include <speechapi_cxx.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Microsoft::CognitiveServices::Speech;
+using namespace Microsoft::CognitiveServices::Speech::Audio;
+
+// Multiplexes many single-shot recognitions over a small pool of poller
+// threads. Calling RecognizeOnceAsync().get() costs a blocked thread (and its
+// stack) per in-flight utterance, which does not scale to load-generator
+// volumes. Instead, this driver keeps a fixed table of in-flight slots, each
+// holding a recognizer and the future the SDK returned, and a few poller
+// threads sweep the table: whenever a future is ready its outcome is recorded
+// and the slot is refilled with the next utterance. Thousands of recognitions
+// can be in flight over the run while only pollerThreads + SDK-internal
+// threads exist in the process.
+class RecognitionMultiplexer final
+{
+public:
+
+    RecognitionMultiplexer(shared_ptr<SpeechConfig> config, string audioFileName, size_t totalUtterances, size_t maxInFlight)
+        : m_config(move(config)),
+          m_audioFileName(move(audioFileName)),
+          m_totalUtterances(totalUtterances),
+          m_slots(maxInFlight)
+    {
+    }
+
+    // Runs all utterances to completion and prints aggregate throughput.
+    void Run(size_t pollerThreads)
+    {
+        auto start = chrono::steady_clock::now();
+
+        // Fills every slot with an initial in-flight recognition.
+        for (auto& slot : m_slots)
+        {
+            StartNext(slot);
+        }
+
+        // Each poller sweeps a fixed stripe of the slot table, so two pollers
+        // never touch the same slot and the hot path needs no locking.
+        vector<thread> pollers;
+        for (size_t poller = 0; poller < pollerThreads; poller++)
+        {
+            pollers.emplace_back([this, poller, pollerThreads]() { PollSlots(poller, pollerThreads); });
+        }
+        for (auto& poller : pollers)
+        {
+            poller.join();
+        }
+
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Completed " << m_completed.load() << " recognitions"
+            << " (" << m_recognized.load() << " recognized, " << m_failed.load() << " other)"
+            << " in " << elapsed << " s"
+            << " using " << pollerThreads << " poller threads: "
+            << (elapsed > 0 ? m_completed.load() / elapsed : 0) << " utterances/s." << endl;
+    }
+
+private:
+    struct Slot
+    {
+        shared_ptr<SpeechRecognizer> recognizer;
+        future<shared_ptr<SpeechRecognitionResult>> result;
+        bool active = false;
+    };
+
+    // Claims the next utterance number and launches it in 'slot'. Returns false
+    // once all utterances have been started.
+    bool StartNext(Slot& slot)
+    {
+        if (m_started.fetch_add(1) >= m_totalUtterances)
+        {
+            slot.active = false;
+            return false;
+        }
+
+        // Each utterance gets a fresh recognizer over the sample file; only the
+        // future is awaited, so no thread blocks on the recognition itself.
+        auto audioInput = AudioConfig::FromWavFileInput(m_audioFileName);
+        slot.recognizer = SpeechRecognizer::FromConfig(m_config, audioInput);
+        slot.result = slot.recognizer->RecognizeOnceAsync();
+        slot.active = true;
+        return true;
+    }
+
+    // Sweeps every pollerCount-th slot, harvesting ready futures and refilling
+    // the slots until no utterances remain.
+    void PollSlots(size_t pollerIndex, size_t pollerCount)
+    {
+        for (;;)
+        {
+            bool anyActive = false;
+            for (size_t i = pollerIndex; i < m_slots.size(); i += pollerCount)
+            {
+                auto& slot = m_slots[i];
+                if (!slot.active)
+                {
+                    continue;
+                }
+                anyActive = true;
+
+                if (slot.result.wait_for(chrono::seconds(0)) != future_status::ready)
+                {
+                    continue;
+                }
+
+                auto result = slot.result.get();
+                m_completed.fetch_add(1);
+                if (result->Reason == ResultReason::RecognizedSpeech)
+                {
+                    m_recognized.fetch_add(1);
+                }
+                else
+                {
+                    m_failed.fetch_add(1);
+                }
+
+                StartNext(slot);
+            }
+
+            if (!anyActive)
+            {
+                return;
+            }
+
+            // All swept slots are still pending; back off briefly instead of spinning.
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+
+private:
+    shared_ptr<SpeechConfig> m_config;
+    string m_audioFileName;
+    size_t m_totalUtterances;
+    vector<Slot> m_slots;
+    atomic<size_t> m_started{ 0 };
+    atomic<size_t> m_completed{ 0 };
+    atomic<size_t> m_recognized{ 0 };
+    atomic<size_t> m_failed{ 0 };
+};
+
+// Runs a load-generator style batch of single-shot recognitions multiplexed
+// over two poller threads.
+void SpeechRecognitionMultiplexerDemo()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Adjust the volume and concurrency to match your load profile; in-flight
+    // recognitions cost a table slot each, not a blocked thread each.
+    constexpr size_t totalUtterances = 100;
+    constexpr size_t maxInFlight = 16;
+    constexpr size_t pollerThreads = 2;
+
+    cout << "Running " << totalUtterances << " single-shot recognitions, "
+        << maxInFlight << " in flight..." << endl;
+
+    RecognitionMultiplexer multiplexer(config, "whatstheweatherlike.wav", totalUtterances, maxInFlight);
+    multiplexer.Run(pollerThreads);
+}
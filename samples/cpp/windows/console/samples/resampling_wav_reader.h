@@ -0,0 +1,218 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "wav_file_reader.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__) || defined(__x86_64__)
+#define RESAMPLING_WAV_READER_USE_SSE 1
+#include <xmmintrin.h>
+#endif
+
+// Wraps WavFileReader with a polyphase FIR resampler so native-rate files
+// (typically 44.1 kHz or 48 kHz) can be consumed by the 16 kHz recognition
+// samples directly, with no offline transcode pass. The conversion runs in the
+// Read() path on int16 mono data (stereo input is already downmixed by
+// WavFileReader); the filter-bank dot products are vectorized where available.
+class ResamplingWavReader final
+{
+public:
+
+    // Constructor that creates an input stream from a file and prepares the
+    // filter bank for converting to 'outputSampleRate'.
+    ResamplingWavReader(const std::string& audioFileName, uint32_t outputSampleRate = 16000)
+        : m_reader(audioFileName), m_outputRate(outputSampleRate)
+    {
+        m_inputRate = m_reader.GetSamplesPerSec();
+        if (m_inputRate == 0 || m_outputRate == 0)
+        {
+            throw std::runtime_error("Invalid sample rate for resampling.");
+        }
+        if (m_reader.GetBitsPerSample() != 16 || m_reader.GetChannels() != 1)
+        {
+            throw std::runtime_error("Resampling supports 16-bit mono (or downmixed stereo) input only.");
+        }
+
+        m_step = (double)m_inputRate / m_outputRate;
+        BuildFilterBank();
+    }
+
+    // Copies up to 'size' bytes of 16 kHz mono int16 audio into 'dataBuffer'.
+    // Returns the number of bytes produced, or 0 when the stream reaches end.
+    int Read(uint8_t* dataBuffer, uint32_t size)
+    {
+        if (m_inputRate == m_outputRate)
+        {
+            // Nothing to convert, pass the data through.
+            return m_reader.Read(dataBuffer, size);
+        }
+
+        int16_t* output = (int16_t*)dataBuffer;
+        size_t maxSamples = size / sizeof(int16_t);
+        size_t produced = 0;
+
+        while (produced < maxSamples)
+        {
+            size_t inputIndex = (size_t)m_position;
+            if (inputIndex + taps > m_input.size() && !FillInput(inputIndex + taps))
+            {
+                break;
+            }
+
+            // Selects the filter phase nearest to the fractional input position.
+            double frac = m_position - (double)inputIndex;
+            size_t phase = (size_t)(frac * phases + 0.5);
+            if (phase == phases)
+            {
+                phase = 0;
+                inputIndex++;
+                if (inputIndex + taps > m_input.size() && !FillInput(inputIndex + taps))
+                {
+                    break;
+                }
+            }
+
+            float sample = Dot(&m_input[inputIndex], &m_filterBank[phase * taps]);
+            if (sample > 32767.0f)
+            {
+                sample = 32767.0f;
+            }
+            else if (sample < -32768.0f)
+            {
+                sample = -32768.0f;
+            }
+            output[produced++] = (int16_t)lrintf(sample);
+
+            m_position += m_step;
+
+            // Drops input that can no longer be referenced, so the window stays small.
+            if (m_position >= compactionThreshold)
+            {
+                size_t drop = (size_t)m_position;
+                m_input.erase(m_input.begin(), m_input.begin() + drop);
+                m_position -= (double)drop;
+            }
+        }
+
+        return (int)(produced * sizeof(int16_t));
+    }
+
+    void Close()
+    {
+        m_reader.Close();
+    }
+
+private:
+    // Filter bank geometry: 'phases' quantized fractional delays of a 'taps'-tap lowpass.
+    static constexpr size_t taps = 16;
+    static constexpr size_t phases = 32;
+    static constexpr size_t compactionThreshold = 8192;
+
+    // Designs a windowed-sinc lowpass, split into one normalized filter per phase.
+    void BuildFilterBank()
+    {
+        // Cutoff relative to the input rate, with some transition band headroom.
+        double cutoff = 0.45 * (double)(m_outputRate < m_inputRate ? m_outputRate : m_inputRate) / m_inputRate;
+        const double pi = 3.14159265358979323846;
+        const double center = (double)(taps / 2 - 1);
+
+        m_filterBank.resize(phases * taps);
+        for (size_t p = 0; p < phases; ++p)
+        {
+            double frac = (double)p / phases;
+            double sum = 0.0;
+            for (size_t k = 0; k < taps; ++k)
+            {
+                double t = (double)k - center - frac;
+                double sinc = (t == 0.0) ? 1.0 : sin(2.0 * pi * cutoff * t) / (2.0 * pi * cutoff * t);
+
+                // Blackman window over the tap index keeps the stopband quiet.
+                double w = 0.42 - 0.5 * cos(2.0 * pi * (k + 0.5) / taps) + 0.08 * cos(4.0 * pi * (k + 0.5) / taps);
+                double h = 2.0 * cutoff * sinc * w;
+                m_filterBank[p * taps + k] = (float)h;
+                sum += h;
+            }
+
+            // Normalizes each phase to unity DC gain.
+            for (size_t k = 0; k < taps; ++k)
+            {
+                m_filterBank[p * taps + k] = (float)(m_filterBank[p * taps + k] / sum);
+            }
+        }
+    }
+
+    // Refills the input window until at least 'needed' samples are buffered.
+    // Returns false once the source and the zero-padded tail are exhausted.
+    bool FillInput(size_t needed)
+    {
+        int16_t chunk[4096];
+        while (m_input.size() < needed && !m_endOfFile)
+        {
+            int bytesRead = m_reader.Read((uint8_t*)chunk, sizeof(chunk));
+            if (bytesRead <= 0)
+            {
+                m_endOfFile = true;
+                break;
+            }
+            size_t samples = (size_t)bytesRead / sizeof(int16_t);
+            for (size_t i = 0; i < samples; ++i)
+            {
+                m_input.push_back((float)chunk[i]);
+            }
+        }
+
+        if (m_input.size() < needed)
+        {
+            // Pads once with zeros so the filter can flush its tail, then reports end.
+            if (m_tailFlushed)
+            {
+                return false;
+            }
+            m_tailFlushed = true;
+            m_input.resize(needed, 0.0f);
+        }
+        return true;
+    }
+
+    // Dot product of one input window with one filter phase.
+    static float Dot(const float* input, const float* filter)
+    {
+#if defined(RESAMPLING_WAV_READER_USE_SSE)
+        __m128 acc = _mm_setzero_ps();
+        for (size_t k = 0; k < taps; k += 4)
+        {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(input + k), _mm_loadu_ps(filter + k)));
+        }
+        __m128 shuf = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        shuf = _mm_add_ss(shuf, _mm_shuffle_ps(shuf, shuf, 1));
+        return _mm_cvtss_f32(shuf);
+#else
+        float acc = 0.0f;
+        for (size_t k = 0; k < taps; ++k)
+        {
+            acc += input[k] * filter[k];
+        }
+        return acc;
+#endif
+    }
+
+private:
+    WavFileReader m_reader;
+    uint32_t m_inputRate;
+    uint32_t m_outputRate;
+    double m_step = 1.0;
+    double m_position = 0.0;
+
+    std::vector<float> m_filterBank;
+    std::vector<float> m_input;
+    bool m_endOfFile = false;
+    bool m_tailFlushed = false;
+};
@@ -0,0 +1,230 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#include "stdafx.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "latency_recorder.h"
+#include "thread_placement.h"
+
+using namespace std;
+
+// The non-interactive sample functions the runner can drive. Microphone-bound
+// samples are deliberately absent: they block on live audio and are useless
+// for automated load runs.
+extern void SpeechContinuousRecognitionWithFile();
+extern void SpeechContinuousRecognitionWithPullStream();
+extern void SpeechContinuousRecognitionWithPushStream();
+extern void SpeechBatchRecognitionFromDirectory();
+extern void SpeechRecognitionMultiplexerDemo();
+extern void PronunciationAssessmentBatch();
+extern void TranslationContinuousRecognitionFromCompressedFile();
+extern void IntentContinuousRecognitionWithFile();
+extern void IntentRecognitionBatch();
+extern void SpeechSynthesisToResult();
+extern void SpeechSynthesisToResultWithCache();
+extern void SpeechSynthesisPipelined();
+extern void SpeechSynthesisMultiVoiceFanOut();
+extern void SpeechSynthesisBatchSsmlRender();
+extern void ConversationWithPullAudioStream();
+extern void ConversationWithPushAudioStream();
+extern void SpeakerBulkEnrollment();
+extern void SpeakerIdentificationBatch();
+
+namespace
+{
+    struct Scenario
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    const Scenario scenarios[] =
+    {
+        { "file",                 SpeechContinuousRecognitionWithFile },
+        { "pull-stream",          SpeechContinuousRecognitionWithPullStream },
+        { "push-stream",          SpeechContinuousRecognitionWithPushStream },
+        { "batch-directory",      SpeechBatchRecognitionFromDirectory },
+        { "multiplexer",          SpeechRecognitionMultiplexerDemo },
+        { "pronunciation-batch",  PronunciationAssessmentBatch },
+        { "translation-compressed", TranslationContinuousRecognitionFromCompressedFile },
+        { "intent-file",          IntentContinuousRecognitionWithFile },
+        { "intent-batch",         IntentRecognitionBatch },
+        { "synthesis-result",     SpeechSynthesisToResult },
+        { "synthesis-cached",     SpeechSynthesisToResultWithCache },
+        { "synthesis-pipelined",  SpeechSynthesisPipelined },
+        { "synthesis-fanout",     SpeechSynthesisMultiVoiceFanOut },
+        { "synthesis-batch-ssml", SpeechSynthesisBatchSsmlRender },
+        { "conversation-pull",    ConversationWithPullAudioStream },
+        { "conversation-push",    ConversationWithPushAudioStream },
+        { "speaker-bulk-enroll",  SpeakerBulkEnrollment },
+        { "speaker-id-batch",     SpeakerIdentificationBatch },
+    };
+
+    void PrintUsage()
+    {
+        cout << "Usage: samples run --scenario <name> [--sessions N] [--iterations M]\n"
+            << "                   [--pin-cores LIST | --pin-node NODE] [--report-placement]\n"
+            << "       samples run --list\n\n"
+            << "Runs a sample scenario across N concurrent sessions, M iterations each,\n"
+            << "and prints an aggregate perf report. Without arguments the binary starts\n"
+            << "the interactive menu.\n\n"
+            << "--pin-cores pins session threads round-robin to an explicit core set\n"
+            << "(e.g. 0,2,8-11); --pin-node pins them to one NUMA node's cores, which\n"
+            << "also keeps first-touch buffer allocations node-local. --report-placement\n"
+            << "prints bytes processed per NUMA node at the end of the run.\n";
+    }
+}
+
+// Entry point for scripted runs; returns the process exit code. Invoked from
+// main() whenever command-line arguments are present, so the same binary
+// serves as both the interactive sample menu and a benchmark client.
+int RunScenarioFromCommandLine(const vector<string>& args)
+{
+    if (args.empty() || args[0] != "run")
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    string scenarioName;
+    int sessions = 1;
+    int iterations = 1;
+    for (size_t i = 1; i < args.size(); i++)
+    {
+        if (args[i] == "--list")
+        {
+            cout << "Available scenarios:\n";
+            for (const auto& scenario : scenarios)
+            {
+                cout << "  " << scenario.name << "\n";
+            }
+            return 0;
+        }
+        else if (args[i] == "--scenario" && i + 1 < args.size())
+        {
+            scenarioName = args[++i];
+        }
+        else if (args[i] == "--sessions" && i + 1 < args.size())
+        {
+            sessions = stoi(args[++i]);
+        }
+        else if (args[i] == "--iterations" && i + 1 < args.size())
+        {
+            iterations = stoi(args[++i]);
+        }
+        else if (args[i] == "--pin-cores" && i + 1 < args.size())
+        {
+            if (!ThreadPlacement::Shared().PinToCores(args[++i]))
+            {
+                cout << "Could not parse the core list '" << args[i] << "'.\n";
+                return 1;
+            }
+        }
+        else if (args[i] == "--pin-node" && i + 1 < args.size())
+        {
+            if (!ThreadPlacement::Shared().PinToNode(stoi(args[++i])))
+            {
+                cout << "NUMA node '" << args[i] << "' does not exist or has no cores.\n";
+                return 1;
+            }
+        }
+        else if (args[i] == "--report-placement")
+        {
+            ThreadPlacement::Shared().EnableReport();
+        }
+        else
+        {
+            cout << "Unknown argument '" << args[i] << "'.\n";
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    const Scenario* selected = nullptr;
+    for (const auto& scenario : scenarios)
+    {
+        if (scenarioName == scenario.name)
+        {
+            selected = &scenario;
+            break;
+        }
+    }
+    if (selected == nullptr || sessions < 1 || iterations < 1)
+    {
+        cout << "Unknown scenario '" << scenarioName << "'; use --list to see what is available.\n";
+        return 1;
+    }
+
+    cout << "Running scenario '" << selected->name << "': " << sessions << " sessions x "
+        << iterations << " iterations.\n";
+
+    // Every session thread runs the scenario 'iterations' times and records
+    // per-iteration wall time; exceptions count as failures without taking
+    // down the rest of the run.
+    mutex resultsMutex;
+    vector<double> iterationMillis;
+    iterationMillis.reserve((size_t)sessions * iterations);
+    atomic<int> failures{ 0 };
+    auto runStart = chrono::steady_clock::now();
+
+    vector<thread> sessionThreads;
+    for (int session = 0; session < sessions; session++)
+    {
+        sessionThreads.emplace_back([&, session]()
+        {
+            // Pinning happens before the first iteration allocates anything,
+            // so the session's buffers are first-touched on the pinned core.
+            ThreadPlacement::Shared().PinCurrentThread((size_t)session);
+
+            for (int iteration = 0; iteration < iterations; iteration++)
+            {
+                auto iterationStart = chrono::steady_clock::now();
+                try
+                {
+                    selected->run();
+                }
+                catch (const exception& e)
+                {
+                    cout << string("Iteration failed: ") + e.what() + "\n";
+                    failures.fetch_add(1);
+                    continue;
+                }
+                auto millis = chrono::duration<double, milli>(chrono::steady_clock::now() - iterationStart).count();
+
+                lock_guard<mutex> lock(resultsMutex);
+                iterationMillis.push_back(millis);
+            }
+        });
+    }
+
+    for (auto& sessionThread : sessionThreads)
+    {
+        sessionThread.join();
+    }
+
+    auto elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+    size_t completed = iterationMillis.size();
+
+    cout << "Scenario '" << selected->name << "': " << completed << " iterations completed, "
+        << failures.load() << " failed, " << elapsedSeconds << " s elapsed ("
+        << completed / elapsedSeconds << " iterations/sec across " << sessions << " sessions).\n";
+    if (!iterationMillis.empty())
+    {
+        LatencyRecorder::PrintPercentiles("Iteration wall time (ms)", iterationMillis);
+    }
+    if (ThreadPlacement::Shared().ReportEnabled())
+    {
+        ThreadPlacement::Shared().PrintReport();
+    }
+    return failures.load() == 0 ? 0 : 2;
+}
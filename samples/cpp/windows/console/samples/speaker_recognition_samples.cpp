@@ -6,10 +6,15 @@
 #include "stdafx.h"
 
 // <toplevel>
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <thread>
 #include <vector>
 #include <speechapi_cxx.h>
 #include "wav_file_reader.h"
+#include "audio_buffer_pool.h"
+#include "voice_profile_store.h"
 
 using namespace std;
 using namespace Microsoft::CognitiveServices::Speech;
@@ -48,6 +53,36 @@ private:
     WavFileReader m_reader;
 };
 
+// A pull stream callback whose source file can be swapped between
+// recognitions, so one recognizer and its warm connection can be fed a whole
+// batch of clips instead of rebuilding the audio apparatus per file.
+class SwappableAudioInputCallback final : public PullAudioInputStreamCallback
+{
+public:
+    // Points the callback at the next clip; call between recognitions only.
+    void SetFile(const string& audioFileName)
+    {
+        m_reader = make_unique<WavFileReader>(audioFileName);
+    }
+
+    int Read(uint8_t* dataBuffer, uint32_t size) override
+    {
+        return m_reader ? m_reader->Read(dataBuffer, size) : 0;
+    }
+
+    void Close() override
+    {
+        if (m_reader)
+        {
+            m_reader->Close();
+            m_reader.reset();
+        }
+    }
+
+private:
+    std::unique_ptr<WavFileReader> m_reader;
+};
+
 // helper functions
 shared_ptr<VoiceProfile> VoiceProfileEnrollmentWithMicrophone(const shared_ptr<VoiceProfileClient>& client);
 void VerifyVoiceProfileFromMicrophone(const shared_ptr<SpeechConfig>& config, const shared_ptr<VoiceProfile>& profile);
@@ -123,52 +158,66 @@ void SpeakerVerificationWithPushStream()
     // Creates a VoiceProfileClient to create voice profiles and train voice profiles.
     auto client = VoiceProfileClient::FromConfig(config);
 
-    // Creates a voice profile using the client.
-    auto profile = client->CreateProfileAsync(VoiceProfileType::TextDependentVerification, "en-us").get();
-    cout << "Created a text dependent verification profile " << profile->GetId() << endl;
-
-    // The source of the push streams is three recorded audio files.
-    vector<string> trainingFilenames { audioDirName+"myVoiceIsMyPassportVerifyMe01.wav", audioDirName+"myVoiceIsMyPassportVerifyMe02.wav", audioDirName + "myVoiceIsMyPassportVerifyMe03.wav" };
-    bool enrolled = false;
-
-    // for each audio file, create a push stream and feed it to the voice profile client.
-    for (auto& trainingFilename: trainingFilenames)
+    // Checks the on-disk profile store first; a hit skips profile creation and
+    // the three enrollment round trips entirely.
+    VoiceProfileStore profileStore("voice_profiles.tsv");
+    const string speakerKey = "push-stream-verification-speaker";
+    auto profile = profileStore.TryGet(client, speakerKey);
+    bool enrolled = (profile != nullptr);
+    if (enrolled)
     {
-        // Creates a push stream
-        auto pushStream = AudioInputStream::CreatePushStream();
-
-        // Creates an audio config object from stream input;
-        auto audioInput = AudioConfig::FromStreamInput(pushStream);
-
-        // Pushes audio into the voice profile client.
-        auto error = PushData(trainingFilename, pushStream);
-        if (error)
-        {
-            return;
-        }
+        cout << "Reusing enrolled verification profile " << profile->GetId() << " from the store." << endl;
+    }
+    else
+    {
+        // Creates a voice profile using the client.
+        profile = client->CreateProfileAsync(VoiceProfileType::TextDependentVerification, "en-us").get();
+        cout << "Created a text dependent verification profile " << profile->GetId() << endl;
 
-        // Enrolls the voice profile using the push stream
-        auto result = client->EnrollProfileAsync(profile, audioInput).get();
+        // The source of the push streams is three recorded audio files.
+        vector<string> trainingFilenames { audioDirName+"myVoiceIsMyPassportVerifyMe01.wav", audioDirName+"myVoiceIsMyPassportVerifyMe02.wav", audioDirName + "myVoiceIsMyPassportVerifyMe03.wav" };
 
-        if (result->Reason == ResultReason::EnrolledVoiceProfile)
-        {
-            cout << "Enrolled.\n";
-            enrolled = true;
-            break;
-        }
-        // More audio are needed to enroll the voice profile.
-        else if (result->Reason == ResultReason::EnrollingVoiceProfile)
+        // for each audio file, create a push stream and feed it to the voice profile client.
+        for (auto& trainingFilename: trainingFilenames)
         {
-            cout << "RemainingEnrollmentCount " << result->GetEnrollmentInfo(EnrollmentInfoType::RemainingEnrollmentsCount) << endl;
-            cout << "Accepted " << result->GetEnrollmentInfo(EnrollmentInfoType::EnrollmentsCount) << " Utterances.\n";
-        }
-        // Something went wrong while enrolling the voice profile.
-        else if (result->Reason == ResultReason::Canceled)
-        {
-            auto cancellation = VoiceProfileEnrollmentCancellationDetails::FromResult(result);
-            cout << "CANCELED: ErrorCode=" << (int)cancellation->ErrorCode << std::endl;
-            cout << "CANCELED: ErrorDetails=" << cancellation->ErrorDetails << std::endl;
-            break;
+            // Creates a push stream
+            auto pushStream = AudioInputStream::CreatePushStream();
+
+            // Creates an audio config object from stream input;
+            auto audioInput = AudioConfig::FromStreamInput(pushStream);
+
+            // Pushes audio into the voice profile client.
+            auto error = PushData(trainingFilename, pushStream);
+            if (error)
+            {
+                return;
+            }
+
+            // Enrolls the voice profile using the push stream
+            auto result = client->EnrollProfileAsync(profile, audioInput).get();
+
+            if (result->Reason == ResultReason::EnrolledVoiceProfile)
+            {
+                cout << "Enrolled.\n";
+                enrolled = true;
+                // Persists the profile id so the next run starts verifying immediately.
+                profileStore.Put(speakerKey, profile);
+                break;
+            }
+            // More audio are needed to enroll the voice profile.
+            else if (result->Reason == ResultReason::EnrollingVoiceProfile)
+            {
+                cout << "RemainingEnrollmentCount " << result->GetEnrollmentInfo(EnrollmentInfoType::RemainingEnrollmentsCount) << endl;
+                cout << "Accepted " << result->GetEnrollmentInfo(EnrollmentInfoType::EnrollmentsCount) << " Utterances.\n";
+            }
+            // Something went wrong while enrolling the voice profile.
+            else if (result->Reason == ResultReason::Canceled)
+            {
+                auto cancellation = VoiceProfileEnrollmentCancellationDetails::FromResult(result);
+                cout << "CANCELED: ErrorCode=" << (int)cancellation->ErrorCode << std::endl;
+                cout << "CANCELED: ErrorDetails=" << cancellation->ErrorDetails << std::endl;
+                break;
+            }
         }
     }
 
@@ -191,9 +240,27 @@ void SpeakerIdentificationWithPullStream()
     // Creates a VoiceProfileClient to create voice profiles and train voice profiles.
     auto client = VoiceProfileClient::FromConfig(config);
 
-    // Creates and train two voice profiles.
-    auto profile1 = VoiceProfileEnrollmentWithPullStream(client, audioDirName + "aboutSpeechSdk.wav");
-    auto profile2 = VoiceProfileEnrollmentWithPullStream(client, audioDirName + "speechService.wav");
+    // Creates and train two voice profiles, reusing enrolled profiles from the
+    // on-disk store (keyed by the enrollment audio file) when available.
+    VoiceProfileStore profileStore("voice_profiles.tsv");
+    auto enrollOnce = [&](const string& filename)
+    {
+        auto profile = profileStore.TryGet(client, filename);
+        if (profile != nullptr)
+        {
+            cout << "Reusing enrolled identification profile " << profile->GetId() << " from the store." << endl;
+            return profile;
+        }
+
+        profile = VoiceProfileEnrollmentWithPullStream(client, filename);
+        if (!profile->GetId().empty())
+        {
+            profileStore.Put(filename, profile);
+        }
+        return profile;
+    };
+    auto profile1 = enrollOnce(audioDirName + "aboutSpeechSdk.wav");
+    auto profile2 = enrollOnce(audioDirName + "speechService.wav");
 
     if (!profile1->GetId().empty() && !profile2->GetId().empty())
     {
@@ -224,6 +291,156 @@ void SpeakerIdentificationWithMicrophone()
     }
 }
 
+// Bulk speaker enrollment with a bounded pool of concurrent workers.
+// Onboarding a batch of speakers one blocking enrollment at a time leaves the
+// service idle while audio is pushed and the client idle while the service
+// processes; this driver keeps several enrollments in flight on one shared
+// VoiceProfileClient and overlaps each speaker's audio push with the
+// service-side waits of the others.
+void SpeakerBulkEnrollment()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // One client is shared by all workers; each enrollment gets its own
+    // profile and push stream.
+    auto client = VoiceProfileClient::FromConfig(config);
+
+    // Simulated onboarding batch; in production each speaker would have their
+    // own recordings. Replace with your own speaker roster.
+    vector<string> trainingFilenames { audioDirName + "myVoiceIsMyPassportVerifyMe01.wav", audioDirName + "myVoiceIsMyPassportVerifyMe02.wav", audioDirName + "myVoiceIsMyPassportVerifyMe03.wav" };
+    constexpr int speakerCount = 8;
+    constexpr int workerCount = 4;
+
+    atomic<int> nextSpeaker{ 0 };
+    atomic<int> enrolledSpeakers{ 0 };
+    auto batchStart = chrono::steady_clock::now();
+
+    vector<thread> workers;
+    for (int workerIndex = 0; workerIndex < workerCount; workerIndex++)
+    {
+        workers.emplace_back([&]()
+        {
+            int speaker;
+            while ((speaker = nextSpeaker.fetch_add(1)) < speakerCount)
+            {
+                // Creates a voice profile for this speaker using the shared client.
+                auto profile = client->CreateProfileAsync(VoiceProfileType::TextDependentVerification, "en-us").get();
+
+                for (auto& trainingFilename : trainingFilenames)
+                {
+                    // Creates a push stream and an audio config object from it.
+                    auto pushStream = AudioInputStream::CreatePushStream();
+                    auto audioInput = AudioConfig::FromStreamInput(pushStream);
+
+                    // Starts the enrollment before pushing audio so the service
+                    // consumes the stream while this worker is still feeding it.
+                    auto enrollment = client->EnrollProfileAsync(profile, audioInput);
+                    auto error = PushData(trainingFilename, pushStream);
+                    if (error)
+                    {
+                        return;
+                    }
+                    auto result = enrollment.get();
+
+                    if (result->Reason == ResultReason::EnrolledVoiceProfile)
+                    {
+                        cout << "Speaker " + to_string(speaker + 1) + ": enrolled profile " + profile->GetId() + "\n";
+                        enrolledSpeakers.fetch_add(1);
+                        break;
+                    }
+                    // Something went wrong while enrolling the voice profile;
+                    // EnrollingVoiceProfile just continues with the next file.
+                    else if (result->Reason == ResultReason::Canceled)
+                    {
+                        auto cancellation = VoiceProfileEnrollmentCancellationDetails::FromResult(result);
+                        cout << "Speaker " + to_string(speaker + 1) + " CANCELED: ErrorDetails=" + cancellation->ErrorDetails + "\n";
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    auto elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - batchStart).count();
+    cout << "Enrolled " << enrolledSpeakers.load() << " of " << speakerCount << " speakers in "
+        << elapsedSeconds << " s with " << workerCount << " workers ("
+        << enrolledSpeakers.load() / elapsedSeconds << " enrollments/sec)." << endl;
+}
+
+// Speaker identification over a batch of clips with one shared model and recognizer.
+// The per-file apparatus in VoiceProfileIdentificationWithPullStream is
+// rebuilt for every clip; for screening thousands of clips against the same
+// profile population this builds the SpeakerIdentificationModel and
+// SpeakerRecognizer once and swaps the pull stream's source file between
+// recognitions, keeping the service connection warm between clips.
+void SpeakerIdentificationBatch()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Creates a VoiceProfileClient to create voice profiles and train voice profiles.
+    auto client = VoiceProfileClient::FromConfig(config);
+
+    // Enrolls the profile population once, reusing stored profiles when available.
+    VoiceProfileStore profileStore("voice_profiles.tsv");
+    vector<shared_ptr<VoiceProfile>> profiles;
+    for (auto& enrollmentFilename : { audioDirName + "aboutSpeechSdk.wav", audioDirName + "speechService.wav" })
+    {
+        auto profile = profileStore.TryGet(client, enrollmentFilename);
+        if (profile == nullptr)
+        {
+            profile = VoiceProfileEnrollmentWithPullStream(client, enrollmentFilename);
+            if (profile->GetId().empty())
+            {
+                return;
+            }
+            profileStore.Put(enrollmentFilename, profile);
+        }
+        profiles.push_back(profile);
+    }
+
+    // Builds the model, stream and recognizer once for the whole batch.
+    auto model = SpeakerIdentificationModel::FromProfiles(profiles);
+    auto callback = make_shared<SwappableAudioInputCallback>();
+    auto pullStream = AudioInputStream::CreatePullStream(callback);
+    auto audioInput = AudioConfig::FromStreamInput(pullStream);
+    auto speakerRecognizer = SpeakerRecognizer::FromConfig(config, audioInput);
+
+    // The batch of clips to identify; replace with your own clip list.
+    vector<string> clipFilenames { audioDirName + "wikipediaOcelot.wav", audioDirName + "aboutSpeechSdk.wav", audioDirName + "speechService.wav" };
+
+    for (auto& clipFilename : clipFilenames)
+    {
+        // Points the shared stream at the next clip and recognizes it.
+        callback->SetFile(clipFilename);
+        auto clipStart = chrono::steady_clock::now();
+        auto result = speakerRecognizer->RecognizeOnceAsync(model).get();
+        auto clipMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - clipStart).count();
+
+        if (result->Reason == ResultReason::RecognizedSpeakers)
+        {
+            cout << clipFilename << ": most similar voice profile is " << result->ProfileId
+                << " with similarity score " << result->GetScore() << " (" << clipMillis << " ms)" << endl;
+        }
+        // Something went wrong while recognizing the speaker.
+        else if (result->Reason == ResultReason::Canceled)
+        {
+            auto cancellation = SpeakerRecognitionCancellationDetails::FromResult(result);
+            cout << clipFilename << " CANCELED: ErrorCode=" << (int)cancellation->ErrorCode << std::endl;
+            cout << clipFilename << " CANCELED: ErrorDetails=" << cancellation->ErrorDetails << std::endl;
+            break;
+        }
+    }
+}
+
 // helper function for speaker verification.
 void VerifyVoiceProfileFromMicrophone(const shared_ptr<SpeechConfig>& config, const shared_ptr<VoiceProfile>& profile)
 {
@@ -264,13 +481,15 @@ int PushData(const string& filename, shared_ptr<PushAudioInputStream>& pushStrea
     {
         WavFileReader reader(filename);
 
-        vector<uint8_t> buffer(1000);
+        // Leases a recycled feed buffer from the shared pool instead of allocating
+        // a fresh vector per utterance.
+        auto buffer = AudioBufferPool::Shared().Acquire();
         // Read data and push them into the stream
         int readSamples = 0;
-        while ((readSamples = reader.Read(buffer.data(), (uint32_t)buffer.size())) != 0)
+        while ((readSamples = reader.Read(buffer.Data(), (uint32_t)buffer.Size())) != 0)
         {
             // Push a buffer into the stream
-            pushStream->Write(buffer.data(), readSamples);
+            pushStream->Write(buffer.Data(), readSamples);
         }
 
         // Close the push stream.
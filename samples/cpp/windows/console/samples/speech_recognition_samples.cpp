@@ -7,8 +7,39 @@
 
 // <toplevel>
 #include <speechapi_cxx.h>
+#include <chrono>
 #include <fstream>
+#include <future>
+#include <thread>
 #include "wav_file_reader.h"
+#include "memory_mapped_wav_file_reader.h"
+#include "binary_transcript.h"
+#include "streaming_wav_reader.h"
+#include "resampling_wav_reader.h"
+#include "audio_buffer_pool.h"
+#include "spsc_ring_buffer.h"
+#include "console_event_writer.h"
+#include "detailed_result_view.h"
+#include "double_buffered_file_writer.h"
+#include "latency_recorder.h"
+#include "metrics_writer.h"
+#include "stream_counters.h"
+#include "thread_placement.h"
+#include "voice_activity_gate.h"
+#include "keyword_model_cache.h"
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
 
 using namespace std;
 using namespace Microsoft::CognitiveServices::Speech;
@@ -67,8 +98,9 @@ void SpeechRecognitionWithLanguageAndUsingDetailedOutputFormat()
     // Replace with your own subscription key and service region (e.g., "westus").
     auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
 
-    // Request detailed output format.
+    // Request detailed output format with per-word timings.
     config->SetOutputFormat(OutputFormat::Detailed);
+    config->RequestWordLevelTimestamps();
 
     // Creates a speech recognizer in the specified language using microphone as audio input.
     // Replace the language with your language in BCP-47 format, e.g. en-US.
@@ -87,9 +119,25 @@ void SpeechRecognitionWithLanguageAndUsingDetailedOutputFormat()
     // Checks result.
     if (result->Reason == ResultReason::RecognizedSpeech)
     {
-        cout << "RECOGNIZED: Text=" << result->Text << std::endl
-             << "  Speech Service JSON: " << result->Properties.GetProperty(PropertyId::SpeechServiceResponse_JsonResult)
-             << std::endl;
+        cout << "RECOGNIZED: Text=" << result->Text << std::endl;
+
+        // The detailed N-best payload is read through the lazy zero-copy view:
+        // one scan indexes the fields as slices of this JSON string, so no DOM
+        // is built and nothing is copied. The string must outlive the view.
+        auto json = result->Properties.GetProperty(PropertyId::SpeechServiceResponse_JsonResult);
+        DetailedResultView detailed(json);
+        for (size_t i = 0; i < detailed.Count(); i++)
+        {
+            const auto& entry = detailed.Entry(i);
+            cout << "  NBest[" << i << "]: Confidence=" << entry.Confidence
+                 << " Lexical=\"" << entry.Lexical.ToString()
+                 << "\" ITN=\"" << entry.Itn.ToString() << "\"" << std::endl;
+            for (const auto& word : entry.Words)
+            {
+                cout << "    Word=\"" << word.Word.ToString() << "\" Offset=" << word.Offset
+                     << " Duration=" << word.Duration << std::endl;
+            }
+        }
     }
     else if (result->Reason == ResultReason::NoMatch)
     {
@@ -121,26 +169,63 @@ void SpeechContinuousRecognitionWithFile()
     auto audioInput = AudioConfig::FromWavFileInput("whatstheweatherlike.wav");
     auto recognizer = SpeechRecognizer::FromConfig(config, audioInput);
 
+    // Pre-warms the service connection so TLS and websocket setup complete before
+    // any audio flows; short utterances then see service latency only, not the
+    // handshake cost.
+    auto connection = Connection::FromRecognizer(recognizer);
+
+    promise<void> connectionOpened;
+    atomic<bool> connectedOnce{ false };
+    connection->Connected += [&connectionOpened, &connectedOnce](const ConnectionEventArgs& e)
+    {
+        // The event also fires on reconnects; only the first one ends the warm-up.
+        if (!connectedOnce.exchange(true))
+        {
+            connectionOpened.set_value();
+        }
+    };
+
+    auto connectStart = chrono::steady_clock::now();
+    connection->Open(true); // true: the connection will be used for continuous recognition.
+
+    // Open() failures (bad key or region, no network) surface through the
+    // recognizer's Canceled event rather than here, so the warm-up wait is
+    // bounded: on timeout fall through to the normal start path and let the
+    // Canceled handler below report what went wrong.
+    if (connectionOpened.get_future().wait_for(chrono::seconds(10)) == future_status::ready)
+    {
+        auto connectElapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - connectStart);
+        cout << "Connection setup took " << connectElapsed.count() << " ms." << std::endl;
+    }
+    else
+    {
+        cout << "Connection was not opened within 10 s; starting recognition without the warm-up." << std::endl;
+    }
+
     // promise for synchronization of recognition end.
     promise<void> recognitionEnd;
 
-    // Subscribes to events.
+    // Subscribes to events. The handlers only enqueue lightweight records; the
+    // terminal writes happen on the shared writer's thread, so a slow console
+    // never blocks the SDK's dispatch thread.
     recognizer->Recognizing.Connect([] (const SpeechRecognitionEventArgs& e)
     {
-        cout << "Recognizing:" << e.Result->Text << std::endl;
+        ConsoleEventWriter::Shared().Write("Recognizing:" + e.Result->Text);
     });
 
     recognizer->Recognized.Connect([] (const SpeechRecognitionEventArgs& e)
     {
         if (e.Result->Reason == ResultReason::RecognizedSpeech)
         {
-            cout << "RECOGNIZED: Text=" << e.Result->Text << "\n"
-                 << "  Offset=" << e.Result->Offset() << "\n"
-                 << "  Duration=" << e.Result->Duration() << std::endl;
+            ostringstream record;
+            record << "RECOGNIZED: Text=" << e.Result->Text << "\n"
+                   << "  Offset=" << e.Result->Offset() << "\n"
+                   << "  Duration=" << e.Result->Duration();
+            ConsoleEventWriter::Shared().Write(record.str());
         }
         else if (e.Result->Reason == ResultReason::NoMatch)
         {
-            cout << "NOMATCH: Speech could not be recognized." << std::endl;
+            ConsoleEventWriter::Shared().Write("NOMATCH: Speech could not be recognized.");
         }
     });
 
@@ -165,13 +250,25 @@ void SpeechContinuousRecognitionWithFile()
     });
 
     // Starts continuous recognition. Uses StopContinuousRecognitionAsync() to stop recognition.
+    auto recognitionStart = chrono::steady_clock::now();
     recognizer->StartContinuousRecognitionAsync().get();
 
     // Waits for recognition end.
     recognitionEnd.get_future().get();
 
-    // Stops recognition.
+    // Stops recognition and reports how long the stop itself took: in a
+    // kill-and-respawn deployment this tail adds up across sessions.
+    auto stopStart = chrono::steady_clock::now();
     recognizer->StopContinuousRecognitionAsync().get();
+    cout << "Graceful stop took "
+         << chrono::duration<double, milli>(chrono::steady_clock::now() - stopStart).count()
+         << " ms." << std::endl;
+
+    // Makes sure all queued event output reaches the terminal.
+    ConsoleEventWriter::Shared().Flush();
+
+    auto recognitionElapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - recognitionStart);
+    cout << "Recognition took " << recognitionElapsed.count() << " ms (connection setup excluded)." << std::endl;
     // </SpeechContinuousRecognitionWithFile>
 }
 
@@ -228,7 +325,9 @@ void SpeechContinuousRecognitionWithPullStream()
     // First, define your own pull audio input stream callback class that implements the
     // PullAudioInputStreamCallback interface. The sample here illustrates how to define such
     // a callback that reads audio data from a wav file.
-    // AudioInputFromFileCallback implements PullAudioInputStreamCallback interface, and uses a wav file as source
+    // AudioInputFromFileCallback implements PullAudioInputStreamCallback interface, and uses a wav file as source.
+    // The file is memory mapped, so each Read() is a pointer bump plus a single memcpy into the SDK buffer
+    // instead of a buffered stream read.
     class AudioInputFromFileCallback final : public PullAudioInputStreamCallback
     {
     public:
@@ -246,7 +345,11 @@ void SpeechContinuousRecognitionWithPullStream()
         // It returns 0 to indicate that the stream reaches end or is closed.
         int Read(uint8_t* dataBuffer, uint32_t size) override
         {
-            return m_reader.Read(dataBuffer, size);
+            // Time spent here is time the SDK's pull thread is starved by us.
+            auto blockedFrom = chrono::steady_clock::now();
+            int bytesRead = m_reader.Read(dataBuffer, size);
+            StreamCounters::Shared().AddReadBlocked(chrono::steady_clock::now() - blockedFrom);
+            return bytesRead;
         }
         // Implements AudioInputStream::Close() which is called when the stream needs to be closed.
         void Close() override
@@ -255,7 +358,7 @@ void SpeechContinuousRecognitionWithPullStream()
         }
 
     private:
-        WavFileReader m_reader;
+        MemoryMappedWavFileReader m_reader;
     };
 
     // Creates an instance of a speech config with specified subscription key and service region.
@@ -275,23 +378,26 @@ void SpeechContinuousRecognitionWithPullStream()
     // promise for synchronization of recognition end.
     promise<void> recognitionEnd;
 
-    // Subscribes to events.
+    // Subscribes to events. Handlers enqueue records for the shared console
+    // writer instead of blocking the SDK's dispatch thread on terminal I/O.
     recognizer->Recognizing.Connect([](const SpeechRecognitionEventArgs& e)
     {
-        cout << "Recognizing:" << e.Result->Text << std::endl;
+        ConsoleEventWriter::Shared().Write("Recognizing:" + e.Result->Text);
     });
 
     recognizer->Recognized.Connect([] (const SpeechRecognitionEventArgs& e)
     {
         if (e.Result->Reason == ResultReason::RecognizedSpeech)
         {
-            cout << "RECOGNIZED: Text=" << e.Result->Text << std::endl
-                 << "  Offset=" << e.Result->Offset() << std::endl
-                 << "  Duration=" << e.Result->Duration() << std::endl;
+            ostringstream record;
+            record << "RECOGNIZED: Text=" << e.Result->Text << "\n"
+                   << "  Offset=" << e.Result->Offset() << "\n"
+                   << "  Duration=" << e.Result->Duration();
+            ConsoleEventWriter::Shared().Write(record.str());
         }
         else if (e.Result->Reason == ResultReason::NoMatch)
         {
-            cout << "NOMATCH: Speech could not be recognized." << std::endl;
+            ConsoleEventWriter::Shared().Write("NOMATCH: Speech could not be recognized.");
         }
     });
 
@@ -326,8 +432,15 @@ void SpeechContinuousRecognitionWithPullStream()
     // Waits for recognition end.
     recognitionEnd.get_future().wait();
 
-    // Stops recognition.
+    // Stops recognition and reports the stop latency.
+    auto stopStart = chrono::steady_clock::now();
     recognizer->StopContinuousRecognitionAsync().wait();
+    cout << "Graceful stop took "
+         << chrono::duration<double, milli>(chrono::steady_clock::now() - stopStart).count()
+         << " ms." << std::endl;
+
+    // Makes sure all queued event output reaches the terminal.
+    ConsoleEventWriter::Shared().Flush();
 }
 
 void SpeechContinuousRecognitionWithPushStream()
@@ -346,23 +459,49 @@ void SpeechContinuousRecognitionWithPushStream()
     // promise for synchronization of recognition end.
     promise<void> recognitionEnd;
 
-    // Subscribes to events.
-    recognizer->Recognizing.Connect([](const SpeechRecognitionEventArgs& e)
+    // Correlates audio-byte submission times with result Offset()/Duration()
+    // to measure first-hypothesis and final-result latency per utterance.
+    LatencyRecorder latency;
+
+    // Machine-readable transcript: fixed-header records plus an offset index,
+    // so post-processing seeks by time instead of re-parsing console text.
+    BinaryTranscriptWriter binaryTranscript("speech_transcript.bin");
+
+    // Subscribes to events. Handlers enqueue records for the shared console
+    // writer instead of blocking the SDK's dispatch thread on terminal I/O.
+    recognizer->Recognizing.Connect([&latency](const SpeechRecognitionEventArgs& e)
     {
-        cout << "Recognizing:" << e.Result->Text << std::endl;
+        latency.OnHypothesis(e.Result->Offset());
+        if (MetricsWriter::Shared().Enabled())
+        {
+            MetricsWriter::Shared().Emit(e.SessionId, "recognizing", e.Result->Offset());
+            return;
+        }
+        ConsoleEventWriter::Shared().Write("Recognizing:" + e.Result->Text);
     });
 
-    recognizer->Recognized.Connect([](const SpeechRecognitionEventArgs& e)
+    recognizer->Recognized.Connect([&latency, &binaryTranscript](const SpeechRecognitionEventArgs& e)
     {
         if (e.Result->Reason == ResultReason::RecognizedSpeech)
         {
-            cout << "RECOGNIZED: Text=" << e.Result->Text << std::endl
-                << "  Offset=" << e.Result->Offset() << std::endl
-                << "  Duration=" << e.Result->Duration() << std::endl;
+            latency.OnFinalResult(e.Result->Offset(), e.Result->Duration());
+            binaryTranscript.Append(e.SessionId, e.Result->Offset(), e.Result->Duration(),
+                (int)e.Result->Reason, e.Result->Text);
+            if (MetricsWriter::Shared().Enabled())
+            {
+                MetricsWriter::Shared().Emit(e.SessionId, "recognized", e.Result->Offset(), e.Result->Duration());
+                return;
+            }
+            ostringstream record;
+            record << "RECOGNIZED: Text=" << e.Result->Text << "\n"
+                   << "  Offset=" << e.Result->Offset() << "\n"
+                   << "  Duration=" << e.Result->Duration();
+            ConsoleEventWriter::Shared().Write(record.str());
         }
         else if (e.Result->Reason == ResultReason::NoMatch)
         {
-            cout << "NOMATCH: Speech could not be recognized." << std::endl;
+            MetricsWriter::Shared().Emit(e.SessionId, "nomatch");
+            ConsoleEventWriter::Shared().Write("NOMATCH: Speech could not be recognized.");
         }
     });
 
@@ -392,115 +531,401 @@ void SpeechContinuousRecognitionWithPushStream()
         recognitionEnd.set_value(); // Notify to stop recognition.
     });
 
-    WavFileReader reader("whatstheweatherlike.wav");
-
-    vector<uint8_t> buffer(1000);
+    // StreamingWavReader parses the wav header without seeking, so besides files it can
+    // also consume non-seekable input directly, e.g. a pipe: StreamingWavReader reader(cin);
+    // For native 44.1/48 kHz files, use ResamplingWavReader instead to convert to 16 kHz
+    // in the Read() path with no offline transcode step. When the same corpus is fed
+    // through thousands of passes, PcmSidecarReader converts once and memory-maps the
+    // cached samples on every later run.
+    StreamingWavReader reader("whatstheweatherlike.wav");
+
+    latency.Start(reader.GetAvgBytesPerSec());
+
+    // Feeder configuration. The leased pool buffer sets the write granularity into
+    // the push stream (100 ms of 16 kHz mono by default; larger chunks mean fewer
+    // Write() calls), and its storage is recycled across sessions instead of being
+    // reallocated per session.
+    // 'pacingFactor' throttles the feed relative to real time as derived from the
+    // wav header's byte rate: 0 pushes as fast as possible, 1 mimics a live audio
+    // source, and N > 1 plays the file at N-times speed for soak testing.
+    constexpr double pacingFactor = 0;
+
+    // 'fastStop' selects the shutdown path once the feed ends: false waits for
+    // the service to finish processing buffered audio before stopping, so every
+    // result is delivered; true stops immediately after the stream closes,
+    // abandoning results for audio still in flight. Both paths report the
+    // StopContinuousRecognitionAsync() latency.
+    constexpr bool fastStop = false;
+
+    auto buffer = AudioBufferPool::Shared().Acquire();
+
+    // One stats line per interval: time the pull side spent blocked, push
+    // throughput, and the synthesis queue depth (zero here).
+    StreamCounters::Shared().StartPeriodicReport();
 
     // Starts continuous recognition. Uses StopContinuousRecognitionAsync() to stop recognition.
     recognizer->StartContinuousRecognitionAsync().wait();
 
-    // Read data and push them into the stream
+    // The read (capture) thread and the thread calling pushStream->Write() are
+    // decoupled by a lock-free SPSC ring, so neither side takes a mutex in the
+    // audio hot path. The drain thread coalesces whatever has accumulated in the
+    // ring into large writes; the brief sleeps below only happen when the ring is
+    // completely empty or completely full.
+    SpscRingBuffer ring(64 * 1024);
+    atomic<bool> feedDone{ false };
+
+    thread drainThread([&ring, &feedDone, &pushStream, &latency]()
+    {
+        vector<uint8_t> drainBuffer(16 * 1024);
+        uint64_t bytesSubmitted = 0;
+        for (;;)
+        {
+            size_t drained = ring.Read(drainBuffer.data(), drainBuffer.size());
+            if (drained == 0)
+            {
+                if (feedDone.load(memory_order_acquire) && ring.ApproximateSize() == 0)
+                {
+                    break;
+                }
+                this_thread::sleep_for(chrono::milliseconds(1));
+                continue;
+            }
+
+            // One large write per drain pass, however small the producer's chunks were.
+            pushStream->Write(drainBuffer.data(), (uint32_t)drained);
+            StreamCounters::Shared().AddBytesPushed(drained);
+            bytesSubmitted += drained;
+            latency.OnAudioSubmitted(bytesSubmitted);
+        }
+
+        // Close the push stream once everything has been drained.
+        pushStream->Close();
+    });
+
+    auto feedStart = chrono::steady_clock::now();
+    uint64_t bytesPushed = 0;
+    auto bytesPerSec = reader.GetAvgBytesPerSec();
+
+    // Gates sub-threshold chunks so long silences are never streamed. Note the
+    // gate compresses the service-side timeline, so result Offset() values no
+    // longer line up with positions in the original file (and neither do the
+    // latency histograms, which assume every byte is streamed).
+    VoiceActivityGate vadGate;
+
+    // Read data and publish them into the ring
     int readSamples = 0;
-    while((readSamples = reader.Read(buffer.data(), (uint32_t)buffer.size())) != 0)
+    while((readSamples = reader.Read(buffer.Data(), (uint32_t)buffer.Size())) != 0)
     {
-        // Push a buffer into the stream
-        pushStream->Write(buffer.data(), readSamples);
+        if (!vadGate.Accept(buffer.Data(), (size_t)readSamples))
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        while (offset < (size_t)readSamples)
+        {
+            size_t accepted = ring.Write(buffer.Data() + offset, readSamples - offset);
+            if (accepted == 0)
+            {
+                // Ring full: the drain thread is behind, yield briefly.
+                this_thread::sleep_for(chrono::milliseconds(1));
+                continue;
+            }
+            offset += accepted;
+        }
+        bytesPushed += readSamples;
+
+        // Sleeps until the pacing clock catches up with the amount of audio pushed.
+        if (pacingFactor > 0 && bytesPerSec > 0)
+        {
+            auto targetElapsed = chrono::microseconds(
+                (uint64_t)(bytesPushed * 1000000.0 / (bytesPerSec * pacingFactor)));
+            this_thread::sleep_until(feedStart + targetElapsed);
+        }
     }
 
-    // Close the push stream.
-    pushStream->Close();
+    // Signal end of input and wait for the drain thread to close the stream.
+    feedDone.store(true, memory_order_release);
+    drainThread.join();
 
-    // Waits for recognition end.
-    recognitionEnd.get_future().get();
+    if (!fastStop)
+    {
+        // Graceful: wait for the service to finish processing buffered audio.
+        recognitionEnd.get_future().get();
+    }
 
-    // Stops recognition.
+    // Stops recognition. With fastStop the stream is already closed and
+    // whatever the service has not processed yet is abandoned.
+    auto stopStart = chrono::steady_clock::now();
     recognizer->StopContinuousRecognitionAsync().get();
+    cout << (fastStop ? "Fast" : "Graceful") << " stop took "
+         << chrono::duration<double, milli>(chrono::steady_clock::now() - stopStart).count()
+         << " ms." << std::endl;
+
+    StreamCounters::Shared().StopPeriodicReport();
+
+    // Trims and closes the binary transcript.
+    binaryTranscript.Close();
+
+    // Makes sure all queued event output reaches the terminal.
+    ConsoleEventWriter::Shared().Flush();
+
+    // Prints p50/p95/p99 of first-hypothesis and final-result latency.
+    latency.PrintSummary();
+
+    // Prints how many bytes the voice activity gate kept off the wire.
+    vadGate.PrintSummary();
 }
 
-// Keyword-triggered speech recognition using microphone.
-void KeywordTriggeredSpeechRecognitionWithMicrophone()
+// Lists the wav files in a directory (non-recursive).
+static vector<string> ListWavFiles(const string& directory)
+{
+    vector<string> files;
+#if defined(_WIN32)
+    WIN32_FIND_DATAA findData;
+    HANDLE findHandle = FindFirstFileA((directory + "\\*.wav").c_str(), &findData);
+    if (findHandle != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            {
+                files.push_back(directory + "\\" + findData.cFileName);
+            }
+        } while (FindNextFileA(findHandle, &findData));
+        FindClose(findHandle);
+    }
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (dir != nullptr)
+    {
+        while (struct dirent* entry = readdir(dir))
+        {
+            string name = entry->d_name;
+            if (name.size() > 4 && name.compare(name.size() - 4, 4, ".wav") == 0)
+            {
+                files.push_back(directory + "/" + name);
+            }
+        }
+        closedir(dir);
+    }
+#endif
+    return files;
+}
+
+// Parallel batch recognition over a directory of wav files.
+// A pool of worker threads pulls files from a shared queue; each worker owns one
+// recognizer that is fed through a push stream and reused for every file it
+// processes, so the per-recognizer construction and connection cost is paid once
+// per worker instead of once per file.
+void SpeechBatchRecognitionFromDirectory()
 {
     // Creates an instance of a speech config with specified subscription key and service region.
     // Replace with your own subscription key and service region (e.g., "westus").
     auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
 
-    // Creates a speech recognizer using microphone as audio input. The default language is "en-us".
-    auto recognizer = SpeechRecognizer::FromConfig(config);
+    // Replace with your own directory of 16 kHz mono wav files, and size the worker
+    // pool for your machine and service quota.
+    const string audioDirectory = "YourAudioDirectory";
+    const size_t workerCount = 4;
 
-    // Promise for synchronization of recognition end.
-    promise<void> recognitionEnd;
+    auto files = ListWavFiles(audioDirectory);
+    if (files.empty())
+    {
+        cout << "No wav files found in " << audioDirectory << std::endl;
+        return;
+    }
 
-    // Subscribes to events.
-    recognizer->Recognizing.Connect([] (const SpeechRecognitionEventArgs& e)
+    // Shared work queue: workers claim the next unprocessed file index.
+    atomic<size_t> nextFile{ 0 };
+    atomic<uint64_t> recognizedUtterances{ 0 };
+    atomic<uint64_t> failedFiles{ 0 };
+
+    auto worker = [&](size_t workerIndex)
     {
-        if (e.Result->Reason == ResultReason::RecognizingSpeech)
+        // With placement configured (scenario runner --pin-cores/--pin-node),
+        // the worker and the buffers it first-touches stay on one core's node.
+        ThreadPlacement::Shared().PinCurrentThread(workerIndex);
+
+        // One recognizer per worker. The push stream stays open across files;
+        // StartContinuousRecognitionAsync/StopContinuousRecognitionAsync delimit
+        // the per-file sessions.
+        auto pushStream = AudioInputStream::CreatePushStream();
+        auto audioInput = AudioConfig::FromStreamInput(pushStream);
+        auto recognizer = SpeechRecognizer::FromConfig(config, audioInput);
+
+        string currentFile;
+
+        recognizer->Recognized.Connect([&currentFile, &recognizedUtterances](const SpeechRecognitionEventArgs& e)
         {
-            cout << "RECOGNIZING: Text=" << e.Result->Text << std::endl;
-        }
-        else if (e.Result->Reason == ResultReason::RecognizingKeyword)
+            if (e.Result->Reason == ResultReason::RecognizedSpeech)
+            {
+                recognizedUtterances++;
+                cout << currentFile << ": " << e.Result->Text << std::endl;
+            }
+        });
+
+        recognizer->Canceled.Connect([&currentFile](const SpeechRecognitionCanceledEventArgs& e)
+        {
+            if (e.Reason == CancellationReason::Error)
+            {
+                cout << currentFile << ": CANCELED: ErrorCode=" << (int)e.ErrorCode
+                     << " ErrorDetails=" << e.ErrorDetails << std::endl;
+            }
+        });
+
+        for (;;)
         {
-            cout << "RECOGNIZING KEYWORD: Text=" << e.Result->Text << std::endl;
+            size_t index = nextFile.fetch_add(1);
+            if (index >= files.size())
+            {
+                break;
+            }
+            currentFile = files[index];
+
+            try
+            {
+                WavFileReader reader(currentFile, 1024 * 1024);
+                auto buffer = AudioBufferPool::Shared().Acquire();
+
+                recognizer->StartContinuousRecognitionAsync().get();
+
+                int readSamples = 0;
+                while ((readSamples = reader.Read(buffer.Data(), (uint32_t)buffer.Size())) != 0)
+                {
+                    pushStream->Write(buffer.Data(), readSamples);
+                    ThreadPlacement::Shared().AddBytes((uint64_t)readSamples);
+                }
+
+                // Stopping flushes the fed audio and ends the per-file session;
+                // the stream itself stays open for the next file.
+                recognizer->StopContinuousRecognitionAsync().get();
+            }
+            catch (const exception& e)
+            {
+                failedFiles++;
+                cout << currentFile << ": skipped (" << e.what() << ")" << std::endl;
+            }
         }
-    });
 
-    recognizer->Recognized.Connect([] (const SpeechRecognitionEventArgs& e)
+        pushStream->Close();
+    };
+
+    auto batchStart = chrono::steady_clock::now();
+
+    vector<thread> workers;
+    for (size_t i = 0; i < workerCount && i < files.size(); ++i)
+    {
+        workers.emplace_back(worker, i);
+    }
+    for (auto& w : workers)
     {
-        if (e.Result->Reason == ResultReason::RecognizedKeyword)
+        w.join();
+    }
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - batchStart);
+    cout << "Processed " << files.size() << " files (" << failedFiles << " failed), "
+         << recognizedUtterances << " utterances recognized in " << elapsed.count() << " ms." << std::endl;
+}
+
+// Keyword-triggered speech recognition using microphone.
+void KeywordTriggeredSpeechRecognitionWithMicrophone()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Runs back-to-back keyword sessions. The first session loads the .table
+    // file into the process-wide cache; later sessions reuse the shared model,
+    // so restarting a session no longer pays the model load.
+    constexpr int sessionCount = 2;
+    for (int session = 0; session < sessionCount; session++)
+    {
+
+        // Creates a speech recognizer using microphone as audio input. The default language is "en-us".
+        auto recognizer = SpeechRecognizer::FromConfig(config);
+
+        // Promise for synchronization of recognition end.
+        promise<void> recognitionEnd;
+
+        // Subscribes to events.
+        recognizer->Recognizing.Connect([] (const SpeechRecognitionEventArgs& e)
         {
-            cout << "RECOGNIZED KEYWORD: Text=" << e.Result->Text << std::endl;
-        }
-        else if (e.Result->Reason == ResultReason::RecognizedSpeech)
+            if (e.Result->Reason == ResultReason::RecognizingSpeech)
+            {
+                cout << "RECOGNIZING: Text=" << e.Result->Text << std::endl;
+            }
+            else if (e.Result->Reason == ResultReason::RecognizingKeyword)
+            {
+                cout << "RECOGNIZING KEYWORD: Text=" << e.Result->Text << std::endl;
+            }
+        });
+
+        recognizer->Recognized.Connect([] (const SpeechRecognitionEventArgs& e)
         {
-            cout << "RECOGNIZED: Text=" << e.Result->Text << std::endl;
-        }
-        else if (e.Result->Reason == ResultReason::NoMatch)
+            if (e.Result->Reason == ResultReason::RecognizedKeyword)
+            {
+                cout << "RECOGNIZED KEYWORD: Text=" << e.Result->Text << std::endl;
+            }
+            else if (e.Result->Reason == ResultReason::RecognizedSpeech)
+            {
+                cout << "RECOGNIZED: Text=" << e.Result->Text << std::endl;
+            }
+            else if (e.Result->Reason == ResultReason::NoMatch)
+            {
+                cout << "NOMATCH: Speech could not be recognized." << std::endl;
+            }
+        });
+
+        recognizer->Canceled.Connect([&recognitionEnd](const SpeechRecognitionCanceledEventArgs& e)
         {
-            cout << "NOMATCH: Speech could not be recognized." << std::endl;
-        }
-    });
+            cout << "CANCELED: Reason=" << (int)e.Reason << std::endl;
 
-    recognizer->Canceled.Connect([&recognitionEnd](const SpeechRecognitionCanceledEventArgs& e)
-    {
-        cout << "CANCELED: Reason=" << (int)e.Reason << std::endl;
+            if (e.Reason == CancellationReason::Error)
+            {
+                cout << "CANCELED: ErrorCode=" << (int)e.ErrorCode << "\n"
+                     << "CANCELED: ErrorDetails=" << e.ErrorDetails << "\n"
+                     << "CANCELED: Did you update the subscription info?" << std::endl;
+            }
+        });
 
-        if (e.Reason == CancellationReason::Error)
+        recognizer->SessionStarted.Connect([&recognitionEnd](const SessionEventArgs& e)
         {
-            cout << "CANCELED: ErrorCode=" << (int)e.ErrorCode << "\n"
-                 << "CANCELED: ErrorDetails=" << e.ErrorDetails << "\n"
-                 << "CANCELED: Did you update the subscription info?" << std::endl;
-        }
-    });
+            cout << "SESSIONSTARTED: SessionId=" << e.SessionId << std::endl;
+        });
 
-    recognizer->SessionStarted.Connect([&recognitionEnd](const SessionEventArgs& e)
-    {
-        cout << "SESSIONSTARTED: SessionId=" << e.SessionId << std::endl;
-    });
+        recognizer->SessionStopped.Connect([&recognitionEnd](const SessionEventArgs& e)
+        {
+            cout << "SESSIONSTOPPED: SessionId=" << e.SessionId << std::endl;
 
-    recognizer->SessionStopped.Connect([&recognitionEnd](const SessionEventArgs& e)
-    {
-        cout << "SESSIONSTOPPED: SessionId=" << e.SessionId << std::endl;
+            recognitionEnd.set_value(); // Notify to stop recognition.
+        });
 
-        recognitionEnd.set_value(); // Notify to stop recognition.
-    });
+        // Fetches the keyword recognition model from the process-wide cache. Update
+        // this to point to the location of your keyword recognition model; the file
+        // is only read on the first session.
+        auto modelFetchStart = chrono::steady_clock::now();
+        auto model = KeywordModelCache::Get("YourKeywordRecognitionModelFile.table");
+        auto modelFetchMs = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - modelFetchStart).count();
+        cout << "Session " << (session + 1) << " of " << sessionCount
+             << ": keyword model ready in " << modelFetchMs << " ms." << std::endl;
 
-    // Creates an instance of a keyword recognition model. Update this to
-    // point to the location of your keyword recognition model.
-    auto model = KeywordRecognitionModel::FromFile("YourKeywordRecognitionModelFile.table");
+        // The phrase your keyword recognition model triggers on.
+        auto keyword = "YourKeyword";
 
-    // The phrase your keyword recognition model triggers on.
-    auto keyword = "YourKeyword";
+        // Starts continuous recognition. Use StopContinuousRecognitionAsync() to stop recognition.
+        recognizer->StartKeywordRecognitionAsync(model).get();
 
-    // Starts continuous recognition. Use StopContinuousRecognitionAsync() to stop recognition.
-    recognizer->StartKeywordRecognitionAsync(model).get();
+        cout << "Say something starting with '" << keyword
+             << "' followed by whatever you want..." << std::endl;
 
-    cout << "Say something starting with '" << keyword
-         << "' followed by whatever you want..." << std::endl;
+        // Waits for a single successful keyword-triggered speech recognition (or error).
+        recognitionEnd.get_future().get();
 
-    // Waits for a single successful keyword-triggered speech recognition (or error).
-    recognitionEnd.get_future().get();
+        // Stops recognition.
+        recognizer->StopKeywordRecognitionAsync().get();
 
-    // Stops recognition.
-    recognizer->StopKeywordRecognitionAsync().get();
+    }
 }
 
 // Speech recognition with auto detection for source language
@@ -646,8 +1071,15 @@ void PronunciationAssessmentWithMicrophone()
         PronunciationAssessmentGranularity::Phoneme, true);
 
     // Creates a speech recognizer using microphone as audio input.
+    // The recognizer, the assessment config and the service connection are all
+    // reused across turns below; only the reference text changes per turn.
     auto recognizer = SpeechRecognizer::FromConfig(config);
 
+    // Opens the connection once up front so the websocket handshake is not part of
+    // the first turn, and stays warm between turns.
+    auto connection = Connection::FromRecognizer(recognizer);
+    connection->Open(false); // false: the connection will be used for single-shot recognition.
+
     while (true)
     {
         // Receives reference text from console input.
@@ -659,14 +1091,21 @@ void PronunciationAssessmentWithMicrophone()
             break;
         }
 
+        // Per-turn setup is just a reference-text swap on the existing config.
+        auto setupStart = chrono::steady_clock::now();
         pronunciationConfig->SetReferenceText(referenceText);
-        cout << "Read out \"" << referenceText << "\" for pronunciation assessment ..." << endl;
-
         pronunciationConfig->ApplyTo(recognizer);
+        auto setupElapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - setupStart);
+
+        cout << "Read out \"" << referenceText << "\" for pronunciation assessment ..." << endl;
 
         // Starts speech recognition, and returns after a single utterance is recognized.
         // For long-running multi-utterance recognition, use StartContinuousRecognitionAsync() instead.
+        auto turnStart = chrono::steady_clock::now();
         auto result = recognizer->RecognizeOnceAsync().get();
+        auto turnElapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - turnStart);
+        cout << "Turn setup took " << setupElapsed.count() << " ms, recognition took "
+             << turnElapsed.count() << " ms." << endl;
 
         // Checks result.
         if (result->Reason == ResultReason::RecognizedSpeech)
@@ -679,6 +1118,20 @@ void PronunciationAssessmentWithMicrophone()
             cout << "    Accuracy score: " << pronunciationResult->AccuracyScore << ", Pronunciation score: "
                  << pronunciationResult->PronunciationScore << ", Completeness score : " << pronunciationResult->CompletenessScore
                  << ", FluencyScore: " << pronunciationResult->FluencyScore << endl;
+
+            // Word timings come from the same detailed payload, read through
+            // the lazy zero-copy view instead of a full DOM parse. The JSON
+            // string must outlive the view.
+            auto json = result->Properties.GetProperty(PropertyId::SpeechServiceResponse_JsonResult);
+            DetailedResultView detailed(json);
+            if (detailed.Count() > 0)
+            {
+                for (const auto& word : detailed.Best().Words)
+                {
+                    cout << "    Word=\"" << word.Word.ToString() << "\" Offset=" << word.Offset
+                         << " Duration=" << word.Duration << endl;
+                }
+            }
         }
         else if (result->Reason == ResultReason::NoMatch)
         {
@@ -698,3 +1151,181 @@ void PronunciationAssessmentWithMicrophone()
         }
     }
 }
+
+// Parallel batch pronunciation assessment over recorded audio.
+// A manifest file pairs each learner recording with its reference text, one
+// tab-separated "<wav path>\t<reference text>" entry per line. A pool of
+// workers pulls entries from a shared queue and scores them concurrently over
+// pull streams; the score records go through a buffered writer so disk I/O
+// never stalls the assessment sessions.
+void PronunciationAssessmentBatch()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    // Note: The pronunciation assessment feature is currently only available on westus, eastasia and centralindia regions.
+    // And this feature is currently only available on en-US language.
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Replace with your own manifest of 16 kHz mono wav files and reference
+    // texts, and size the worker pool for your machine and service quota.
+    const string manifestFileName = "YourManifestFile.tsv";
+    const size_t workerCount = 4;
+
+    struct ManifestEntry
+    {
+        string audioFileName;
+        string referenceText;
+    };
+
+    vector<ManifestEntry> entries;
+    {
+        ifstream manifest(manifestFileName);
+        if (!manifest)
+        {
+            cout << "Could not open the manifest file " << manifestFileName << std::endl;
+            return;
+        }
+        string line;
+        while (getline(manifest, line))
+        {
+            auto tab = line.find('\t');
+            if (tab == string::npos || tab == 0 || tab + 1 >= line.size())
+            {
+                continue;
+            }
+            entries.push_back({ line.substr(0, tab), line.substr(tab + 1) });
+        }
+    }
+    if (entries.empty())
+    {
+        cout << "No entries found in " << manifestFileName << std::endl;
+        return;
+    }
+
+    // Feeds one wav file to the recognizer through a pull stream; the file is
+    // memory mapped, so each Read() is a pointer bump plus a single memcpy.
+    class AssessmentAudioCallback final : public PullAudioInputStreamCallback
+    {
+    public:
+        AssessmentAudioCallback(const string& audioFileName)
+            : m_reader(audioFileName)
+        {
+        }
+
+        int Read(uint8_t* dataBuffer, uint32_t size) override
+        {
+            return m_reader.Read(dataBuffer, size);
+        }
+
+        void Close() override
+        {
+            m_reader.Close();
+        }
+
+    private:
+        MemoryMappedWavFileReader m_reader;
+    };
+
+    // The score records are buffered in memory and written to disk by a
+    // background thread, so a slow disk never backs up into the workers.
+    // DoubleBufferedFileWriter is single-producer; the mutex serializes the
+    // workers' appends.
+    DoubleBufferedFileWriter scoreWriter("pronunciation_scores.tsv");
+    mutex scoreWriterMutex;
+
+    // Shared work queue: workers claim the next unscored manifest entry.
+    atomic<size_t> nextEntry{ 0 };
+    atomic<uint64_t> scoredUtterances{ 0 };
+    atomic<uint64_t> failedUtterances{ 0 };
+
+    auto worker = [&](size_t workerIndex)
+    {
+        // With placement configured (scenario runner --pin-cores/--pin-node),
+        // the worker's sessions all run on one core's node.
+        ThreadPlacement::Shared().PinCurrentThread(workerIndex);
+
+        // The assessment config is reused across entries; only the reference
+        // text changes per utterance. The recognizer is recreated per entry
+        // because the pull stream is bound to one file.
+        auto pronunciationConfig = PronunciationAssessmentConfig::Create("",
+            PronunciationAssessmentGradingSystem::HundredMark,
+            PronunciationAssessmentGranularity::Phoneme, true);
+
+        for (;;)
+        {
+            size_t index = nextEntry.fetch_add(1);
+            if (index >= entries.size())
+            {
+                break;
+            }
+            const auto& entry = entries[index];
+
+            try
+            {
+                auto callback = make_shared<AssessmentAudioCallback>(entry.audioFileName);
+                auto pullStream = AudioInputStream::CreatePullStream(callback);
+                auto audioInput = AudioConfig::FromStreamInput(pullStream);
+                auto recognizer = SpeechRecognizer::FromConfig(config, audioInput);
+
+                pronunciationConfig->SetReferenceText(entry.referenceText);
+                pronunciationConfig->ApplyTo(recognizer);
+
+                auto result = recognizer->RecognizeOnceAsync().get();
+
+                if (result->Reason == ResultReason::RecognizedSpeech)
+                {
+                    auto pronunciationResult = PronunciationAssessmentResult::FromResult(result);
+
+                    ostringstream record;
+                    record << entry.audioFileName
+                        << '\t' << pronunciationResult->AccuracyScore
+                        << '\t' << pronunciationResult->FluencyScore
+                        << '\t' << pronunciationResult->PronunciationScore
+                        << '\t' << pronunciationResult->CompletenessScore
+                        << '\t' << result->Text << '\n';
+                    auto line = record.str();
+
+                    {
+                        lock_guard<mutex> lock(scoreWriterMutex);
+                        scoreWriter.Write(reinterpret_cast<const uint8_t*>(line.data()), line.size());
+                    }
+                    scoredUtterances++;
+                }
+                else
+                {
+                    failedUtterances++;
+                    cout << entry.audioFileName << ": not recognized (reason "
+                         << (int)result->Reason << ")" << std::endl;
+                }
+            }
+            catch (const exception& e)
+            {
+                failedUtterances++;
+                cout << entry.audioFileName << ": skipped (" << e.what() << ")" << std::endl;
+            }
+        }
+    };
+
+    auto batchStart = chrono::steady_clock::now();
+
+    vector<thread> workers;
+    for (size_t i = 0; i < workerCount && i < entries.size(); ++i)
+    {
+        workers.emplace_back(worker, i);
+    }
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+
+    scoreWriter.Close();
+
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - batchStart).count();
+    cout << "Scored " << scoredUtterances << " of " << entries.size() << " utterances ("
+         << failedUtterances << " failed) in " << elapsed << " s";
+    if (elapsed > 0)
+    {
+        cout << " - " << scoredUtterances / elapsed << " utterances/sec";
+    }
+    cout << "." << std::endl;
+}
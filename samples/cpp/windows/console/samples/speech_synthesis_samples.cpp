@@ -7,6 +7,20 @@
 
 #include <speechapi_cxx.h>
 #include <fstream>
+#include <chrono>
+#include <atomic>
+#include <deque>
+#include <future>
+#include <map>
+#include <thread>
+#include "audio_read_arena.h"
+#include "chunked_audio_accumulator.h"
+#include "double_buffered_file_writer.h"
+#include "latency_recorder.h"
+#include "metrics_writer.h"
+#include "ssml_template.h"
+#include "stream_counters.h"
+#include "synthesis_cache.h"
 
 using namespace std;
 using namespace Microsoft::CognitiveServices::Speech;
@@ -157,6 +171,97 @@ void SpeechSynthesisWithVoice()
     }
 }
 
+// Batch SSML rendering with parallel workers and a shared template cache.
+// The templates are parsed once; each worker renders items into its own
+// reusable string buffer (no per-item string churn), synthesizes them with its
+// own synthesizer, and streams the audio to its own output file through the
+// double-buffered writer, so workers share nothing but the work queue.
+void SpeechSynthesisBatchSsmlRender()
+{
+    // The SSML templates the batch renders from; loaded into the shared parsed
+    // cache on first use. Replace with your own (or load them from files).
+    static const string promptTemplateText =
+        "<speak version='1.0' xmlns='https://www.w3.org/2001/10/synthesis' xml:lang='en-US'>"
+        "<voice name='{voice}'>{greeting}, {name}. {body}</voice></speak>";
+
+    const SsmlTemplate& promptTemplate = SsmlTemplateCache::Get("prompt", promptTemplateText);
+
+    // The work list: per-item substitution values. Replace with your own feed.
+    vector<map<string, string>> items;
+    const char* names[] = { "Alice", "Bob", "Carol", "David", "Erin", "Frank" };
+    for (const char* name : names)
+    {
+        items.push_back(
+        {
+            { "voice", "Microsoft Server Speech Text to Speech Voice (en-US, AriaRUS)" },
+            { "greeting", "Good morning" },
+            { "name", name },
+            { "body", "Your order has shipped and will arrive tomorrow." }
+        });
+    }
+
+    constexpr size_t workerCount = 3;
+    atomic<size_t> nextItem{ 0 };
+    atomic<size_t> renderedItems{ 0 };
+
+    auto start = chrono::steady_clock::now();
+
+    vector<thread> workers;
+    for (size_t workerIndex = 0; workerIndex < workerCount; workerIndex++)
+    {
+        workers.emplace_back([workerIndex, &promptTemplate, &items, &nextItem, &renderedItems]()
+        {
+            // Creates an instance of a speech config with specified subscription key and service region.
+            // Replace with your own subscription key and service region (e.g., "westus").
+            auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+            config->SetSpeechSynthesisOutputFormat(SpeechSynthesisOutputFormat::Audio16Khz32KBitRateMonoMp3);
+            auto synthesizer = SpeechSynthesizer::FromConfig(config, nullptr);
+
+            // Per-worker output file and render buffer, reused for every item.
+            DoubleBufferedFileWriter fileWriter("batchoutput_" + to_string(workerIndex) + ".mp3");
+            string ssml;
+
+            for (;;)
+            {
+                size_t item = nextItem.fetch_add(1);
+                if (item >= items.size())
+                {
+                    break;
+                }
+
+                promptTemplate.RenderInto(ssml, items[item]);
+
+                auto result = synthesizer->SpeakSsmlAsync(ssml).get();
+                if (result->Reason == ResultReason::SynthesizingAudioCompleted)
+                {
+                    auto audioData = result->GetAudioData();
+                    fileWriter.Write(audioData->data(), audioData->size());
+                    renderedItems.fetch_add(1);
+                }
+                else if (result->Reason == ResultReason::Canceled)
+                {
+                    auto cancellation = SpeechSynthesisCancellationDetails::FromResult(result);
+                    cout << "CANCELED: Reason=" << (int)cancellation->Reason
+                        << " for item " << item << std::endl;
+                    break;
+                }
+            }
+
+            fileWriter.Close();
+        });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Rendered " << renderedItems.load() << " of " << items.size() << " SSML items in "
+        << elapsed << " s with " << workerCount << " workers ("
+        << (elapsed > 0 ? renderedItems.load() / elapsed : 0) << " items/s)." << endl;
+}
+
 // Speech synthesis to wave file.
 void SpeechSynthesisToWaveFile()
 {
@@ -216,11 +321,23 @@ void SpeechSynthesisToMp3File()
     // https://docs.microsoft.com/azure/cognitive-services/speech-service/rest-text-to-speech#audio-outputs
     config->SetSpeechSynthesisOutputFormat(SpeechSynthesisOutputFormat::Audio16Khz32KBitRateMonoMp3);
 
-    // Creates a speech synthesizer using file as audio output.
+    // Streams the compressed output to disk as it arrives: Synthesizing event
+    // chunks go into a double-buffered writer whose background thread flushes
+    // one buffer while the next fills, so disk I/O overlaps network receive
+    // and memory stays at two buffers however long the synthesis runs.
     // Replace with your own audio file name.
     auto fileName = "outputaudio.mp3";
-    auto fileOutput = AudioConfig::FromWavFileOutput(fileName);
-    auto synthesizer = SpeechSynthesizer::FromConfig(config, fileOutput);
+    DoubleBufferedFileWriter fileWriter(fileName);
+
+    // Creates a speech synthesizer with a null output stream; the audio is
+    // consumed chunk by chunk from the Synthesizing events instead.
+    auto synthesizer = SpeechSynthesizer::FromConfig(config, nullptr);
+
+    synthesizer->Synthesizing += [&fileWriter](const SpeechSynthesisEventArgs& e)
+    {
+        auto audioChunk = e.Result->GetAudioData();
+        fileWriter.Write(audioChunk->data(), audioChunk->size());
+    };
 
     while (true)
     {
@@ -254,6 +371,9 @@ void SpeechSynthesisToMp3File()
             }
         }
     }
+
+    // Flushes the tail buffer and closes the file.
+    fileWriter.Close();
 }
 
 // Speech synthesis to pull audio output stream.
@@ -330,22 +450,21 @@ void SpeechSynthesisToPushAudioOutputStream()
     class PushAudioOutputStreamSampleCallback : public PushAudioOutputStreamCallback
     {
     public:
-        PushAudioOutputStreamSampleCallback()
-        {
-            m_audioData = std::make_shared<std::vector<uint8_t>>();
-        }
-
         /// <summary>
         /// The callback function which is invoked when the synthesizer has a output audio chunk to write out.
+        /// Chunks are appended to a chunk-list accumulator, so a multi-minute synthesis
+        /// never reallocates or recopies what has already been received.
         /// </summary>
         /// <param name="dataBuffer">The output audio chunk sent by synthesizer.</param>
         /// <param name="size">Size of the output audio chunk in bytes.</param>
         /// <returns>Tell synthesizer how many bytes are received.</returns>
         int Write(uint8_t* dataBuffer, uint32_t size) override
         {
-            auto oldSize = m_audioData->size();
-            m_audioData->resize(oldSize + size);
-            memcpy(m_audioData->data() + oldSize, dataBuffer, size);
+            m_audioData.Append(dataBuffer, size);
+
+            // Publishes the accumulated-but-unconsumed byte count as the
+            // synthesis queue depth in the periodic stream stats line.
+            StreamCounters::Shared().SetSynthesisQueueBytes(m_audioData.Size());
 
             cout << size << " bytes received." << endl;
 
@@ -366,20 +485,22 @@ void SpeechSynthesisToPushAudioOutputStream()
         /// <returns>The received audio data size</returns>
         size_t GetAudioSize()
         {
-            return m_audioData->size();
+            return m_audioData.Size();
         }
 
         /// <summary>
-        /// Gets the received audio data
+        /// Gets the received audio data, flattened into one contiguous copy.
+        /// To consume the audio without that copy, use the accumulator's
+        /// ForEachSpan() gather interface instead.
         /// </summary>
         /// <returns>The received audio data in byte vector</returns>
         std::shared_ptr<std::vector<uint8_t>> GetAudioData()
         {
-            return m_audioData;
+            return m_audioData.Flatten();
         }
 
     private:
-        std::shared_ptr<std::vector<uint8_t>> m_audioData;
+        ChunkedAudioAccumulator m_audioData;
     };
 
     // Creates an instance of a speech config with specified subscription key and service region.
@@ -480,6 +601,79 @@ void SpeechSynthesisToResult()
     }
 }
 
+// Gets synthesized audio data from result, served through a persistent cache.
+// Repeated prompts hit the memory-mapped on-disk store and cost microseconds
+// instead of a synthesis round trip; the store also survives process restarts.
+void SpeechSynthesisToResultWithCache()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // The voice and output format are part of the cache key; changing either
+    // renders previously cached prompts invisible rather than stale.
+    auto voice = "en-US-AriaRUS";
+    auto format = "riff-16khz-16bit-mono-pcm";
+    config->SetSpeechSynthesisVoiceName(voice);
+
+    // Stores entries in the current directory; point this at a persistent
+    // location shared by your prompt-serving processes.
+    SynthesisCache cache(".");
+
+    // Creates a speech synthesizer with a null output stream.
+    // This means the audio output data will not be written to any stream.
+    // You can just get the audio from the result.
+    auto synthesizer = SpeechSynthesizer::FromConfig(config, nullptr);
+
+    while (true)
+    {
+        // Receives a text from console input; repeat a text to see the cache hit.
+        cout << "Enter some text that you want to synthesize, or enter empty text to exit." << std::endl;
+        cout << "> ";
+        std::string text;
+        getline(cin, text);
+        if (text.empty())
+        {
+            break;
+        }
+
+        auto lookupStart = chrono::steady_clock::now();
+        const uint8_t* cachedData;
+        size_t cachedSize;
+        if (cache.TryGet(voice, format, text, &cachedData, &cachedSize))
+        {
+            auto lookupMicros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - lookupStart).count();
+            cout << "Cache hit: " << cachedSize << " bytes of audio data for text [" << text
+                << "] served in " << lookupMicros << " us." << endl;
+            continue;
+        }
+
+        auto result = synthesizer->SpeakTextAsync(text).get();
+
+        // Checks result.
+        if (result->Reason == ResultReason::SynthesizingAudioCompleted)
+        {
+            auto audioData = result->GetAudioData();
+            cout << audioData->size() << " bytes of audio data received for text [" << text << "]" << endl;
+
+            // Stores the audio so later requests for this prompt skip the service.
+            cache.Put(voice, format, text, audioData->data(), audioData->size());
+        }
+        else if (result->Reason == ResultReason::Canceled)
+        {
+            auto cancellation = SpeechSynthesisCancellationDetails::FromResult(result);
+            cout << "CANCELED: Reason=" << (int)cancellation->Reason << std::endl;
+
+            if (cancellation->Reason == CancellationReason::Error)
+            {
+                cout << "CANCELED: ErrorCode=" << (int)cancellation->ErrorCode << std::endl;
+                cout << "CANCELED: ErrorDetails=[" << cancellation->ErrorDetails << "]" << std::endl;
+                cout << "CANCELED: Did you update the subscription info?" << std::endl;
+            }
+        }
+    }
+}
+
 // Speech synthesis to audio data stream.
 void SpeechSynthesisToAudioDataStream()
 {
@@ -492,6 +686,10 @@ void SpeechSynthesisToAudioDataStream()
     // You can just get the audio from the result.
     auto synthesizer = SpeechSynthesizer::FromConfig(config, nullptr);
 
+    // One arena reused across requests: each read is a single allocation-free
+    // drain of the stream instead of per-chunk buffer churn.
+    AudioReadArena arena;
+
     while (true)
     {
         // Receives a text from console input and synthesize it to result.
@@ -518,23 +716,82 @@ void SpeechSynthesisToAudioDataStream()
             audioDataStream->SaveToWavFile(fileName.str());
             cout << "Audio data for text [" << text << "] was saved to [" << fileName.str() << "]" << endl;
 
-            // You can also read data from audio data stream and process it in memory
+            // You can also read data from audio data stream and process it in memory.
+            // The result's audio length sizes the arena up front, so the whole
+            // stream lands in one contiguous buffer with large sequential reads.
             // Reset the stream position to the beginnging since saving to file puts the postion to end.
             audioDataStream->SetPosition(0);
 
-            uint8_t buffer[16000];
-            uint32_t totalSize = 0;
-            uint32_t filledSize = 0;
+            size_t totalSize = 0;
+            const uint8_t* audioData = arena.ReadAll(audioDataStream, (size_t)result->GetAudioLength(), &totalSize);
+            UNUSED(audioData); // process the audio in memory here.
 
-            while ((filledSize = audioDataStream->ReadData(buffer, sizeof(buffer))) > 0)
+            cout << "Totally " << totalSize << " bytes received for text [" << text << "]" << endl;
+        }
+        else if (result->Reason == ResultReason::Canceled)
+        {
+            auto cancellation = SpeechSynthesisCancellationDetails::FromResult(result);
+            cout << "CANCELED: Reason=" << (int)cancellation->Reason << std::endl;
+
+            if (cancellation->Reason == CancellationReason::Error)
             {
-                cout << filledSize << " bytes received." << endl;
-                totalSize += filledSize;
+                cout << "CANCELED: ErrorCode=" << (int)cancellation->ErrorCode << std::endl;
+                cout << "CANCELED: ErrorDetails=[" << cancellation->ErrorDetails << "]" << std::endl;
+                cout << "CANCELED: Did you update the subscription info?" << std::endl;
             }
+        }
+    }
+}
 
-            cout << "Totally " << totalSize << " bytes received for text [" << text << "]" << endl;
+// Pipelined speech synthesis: keeps several synthesis requests in flight while
+// the consumer stage plays back completed streams in order. With the serial
+// SpeakTextAsync(text).get() pattern, the round trip for sentence N+1 only
+// starts after sentence N has finished; here StartSpeakingTextAsync() returns
+// as soon as synthesis begins, so while the consumer reads one stream the
+// service is already producing the next ones and inter-sentence gaps shrink to
+// roughly zero.
+void SpeechSynthesisPipelined()
+{
+    // Creates an instance of a speech config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Creates a speech synthesizer with a null output stream.
+    // The consumer stage below reads the audio from per-request data streams.
+    auto synthesizer = SpeechSynthesizer::FromConfig(config, nullptr);
+
+    // A multi-sentence output, e.g. a dialog system turn. Replace with your own.
+    vector<string> sentences =
+    {
+        "The first sentence is already playing while the rest are synthesized.",
+        "The second sentence was requested before the first finished.",
+        "So was the third, keeping the pipeline full.",
+        "The fourth sentence streams in right behind it.",
+        "And the fifth closes out the paragraph without a gap."
+    };
+
+    // Number of synthesis requests kept in flight ahead of playback. Depth 1
+    // degenerates to the serial pattern; 2-3 is enough to hide typical service
+    // latency behind sentence-length playback.
+    constexpr size_t pipelineDepth = 3;
+
+    deque<future<shared_ptr<SpeechSynthesisResult>>> inFlight;
+    size_t nextSentence = 0;
+    auto start = chrono::steady_clock::now();
+
+    while (nextSentence < sentences.size() || !inFlight.empty())
+    {
+        // Keeps the pipeline topped up to its configured depth.
+        while (inFlight.size() < pipelineDepth && nextSentence < sentences.size())
+        {
+            inFlight.push_back(synthesizer->StartSpeakingTextAsync(sentences[nextSentence++]));
         }
-        else if (result->Reason == ResultReason::Canceled)
+
+        // Consumes the oldest request, so playback order matches sentence order.
+        auto result = inFlight.front().get();
+        inFlight.pop_front();
+
+        if (result->Reason == ResultReason::Canceled)
         {
             auto cancellation = SpeechSynthesisCancellationDetails::FromResult(result);
             cout << "CANCELED: Reason=" << (int)cancellation->Reason << std::endl;
@@ -545,7 +802,124 @@ void SpeechSynthesisToAudioDataStream()
                 cout << "CANCELED: ErrorDetails=[" << cancellation->ErrorDetails << "]" << std::endl;
                 cout << "CANCELED: Did you update the subscription info?" << std::endl;
             }
+            break;
+        }
+
+        // The consumer (playback) stage: ReadData() blocks only when playback
+        // catches up with synthesis, which the pipeline depth makes rare.
+        auto audioDataStream = AudioDataStream::FromResult(result);
+        uint8_t buffer[16000];
+        uint32_t totalSize = 0;
+        uint32_t filledSize = 0;
+        while ((filledSize = audioDataStream->ReadData(buffer, sizeof(buffer))) > 0)
+        {
+            // Hand 'buffer' to your audio device here.
+            totalSize += filledSize;
         }
+
+        size_t consumedSentence = nextSentence - inFlight.size();
+        cout << totalSize << " bytes consumed for sentence " << consumedSentence
+            << " of " << sentences.size() << "." << endl;
+    }
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+    cout << sentences.size() << " sentences consumed in " << elapsed.count() << " ms with depth "
+        << pipelineDepth << " pipeline." << endl;
+}
+
+// Concurrent multi-voice synthesis fan-out. Pre-rendering a prompt set in
+// many voices with a serial loop serializes every service round trip; here
+// each voice gets its own worker with its own synthesizer and its own output
+// accumulator, so the voices render the shared prompt list in parallel with
+// no contention between workers. Wall-clock time and per-voice throughput are
+// reported at the end.
+void SpeechSynthesisMultiVoiceFanOut()
+{
+    // The voices to render the prompt set in. Extend to your full A/B set.
+    vector<string> voices =
+    {
+        "en-US-AriaRUS",
+        "en-US-ZiraRUS",
+        "en-US-BenjaminRUS",
+        "en-US-GuyRUS"
+    };
+
+    // The shared prompt list every voice renders. Replace with your own.
+    vector<string> texts =
+    {
+        "Welcome, how can I help you today?",
+        "Please hold while I transfer your call.",
+        "Your request has been completed.",
+        "Is there anything else I can do for you?",
+        "Thank you for calling, goodbye."
+    };
+
+    // Per-voice results, sized up front so workers never touch shared state.
+    struct VoiceRendering
+    {
+        ChunkedAudioAccumulator audio;
+        size_t promptsRendered = 0;
+        double elapsedSeconds = 0;
+    };
+    vector<VoiceRendering> renderings(voices.size());
+
+    auto start = chrono::steady_clock::now();
+
+    vector<thread> workers;
+    for (size_t voiceIndex = 0; voiceIndex < voices.size(); voiceIndex++)
+    {
+        workers.emplace_back([voiceIndex, &voices, &texts, &renderings]()
+        {
+            // Creates an instance of a speech config with specified subscription key and service region.
+            // Replace with your own subscription key and service region (e.g., "westus").
+            // Each worker owns its config and synthesizer, so setting the voice
+            // here cannot race with the other workers.
+            auto config = SpeechConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+            config->SetSpeechSynthesisVoiceName(voices[voiceIndex]);
+            auto synthesizer = SpeechSynthesizer::FromConfig(config, nullptr);
+
+            auto& rendering = renderings[voiceIndex];
+            auto voiceStart = chrono::steady_clock::now();
+
+            for (const auto& text : texts)
+            {
+                auto result = synthesizer->SpeakTextAsync(text).get();
+                if (result->Reason == ResultReason::SynthesizingAudioCompleted)
+                {
+                    // Accumulates into the worker's own chunk list; write the
+                    // spans out to per-voice files here as needed.
+                    auto audioData = result->GetAudioData();
+                    rendering.audio.Append(audioData->data(), audioData->size());
+                    rendering.promptsRendered++;
+                }
+                else if (result->Reason == ResultReason::Canceled)
+                {
+                    auto cancellation = SpeechSynthesisCancellationDetails::FromResult(result);
+                    cout << "CANCELED: Reason=" << (int)cancellation->Reason
+                        << " for voice " << voices[voiceIndex] << std::endl;
+                    break;
+                }
+            }
+
+            rendering.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - voiceStart).count();
+        });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    auto wallClock = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Rendered " << texts.size() << " prompts in " << voices.size()
+        << " voices in " << wallClock << " s wall clock." << endl;
+    for (size_t voiceIndex = 0; voiceIndex < voices.size(); voiceIndex++)
+    {
+        auto& rendering = renderings[voiceIndex];
+        cout << "  " << voices[voiceIndex] << ": " << rendering.promptsRendered << " prompts, "
+            << rendering.audio.Size() << " bytes in " << rendering.elapsedSeconds << " s ("
+            << (rendering.elapsedSeconds > 0 ? rendering.promptsRendered / rendering.elapsedSeconds : 0)
+            << " prompts/s)." << endl;
     }
 }
 
@@ -561,6 +935,19 @@ void SpeechSynthesisEvents()
     // You can just get the audio from the result.
     auto synthesizer = SpeechSynthesizer::FromConfig(config, nullptr);
 
+    // Per-request timing state. The submission time is stamped right before
+    // SpeakTextAsync; the first Synthesizing event gives time-to-first-byte
+    // and SynthesisCompleted closes the request.
+    chrono::steady_clock::time_point requestSubmitted;
+    chrono::steady_clock::time_point firstChunkReceived;
+    bool firstChunkSeen = false;
+    uint64_t requestBytes = 0;
+
+    // Per-run samples for the percentile summary.
+    vector<double> ttfbMillis;
+    vector<double> completionMillis;
+    vector<double> streamingRates;
+
     // Subscribes to events
     synthesizer->SynthesisStarted += [](const SpeechSynthesisEventArgs& e)
     {
@@ -568,15 +955,50 @@ void SpeechSynthesisEvents()
         cout << "Synthesis started." << endl;
     };
 
-    synthesizer->Synthesizing += [](const SpeechSynthesisEventArgs& e)
+    synthesizer->Synthesizing += [&](const SpeechSynthesisEventArgs& e)
     {
-        cout << "Synthesizing event received with audio chunk of " << e.Result->GetAudioData()->size() << " bytes" << endl;
+        auto now = chrono::steady_clock::now();
+        auto chunkSize = e.Result->GetAudioData()->size();
+        requestBytes += chunkSize;
+
+        if (!firstChunkSeen)
+        {
+            firstChunkSeen = true;
+            firstChunkReceived = now;
+            auto ttfb = chrono::duration<double, milli>(now - requestSubmitted).count();
+            ttfbMillis.push_back(ttfb);
+            if (MetricsWriter::Shared().Enabled())
+            {
+                MetricsWriter::Shared().Emit(e.Result->ResultId, "synthesis-first-byte", -1, -1, ttfb);
+                return;
+            }
+            cout << "First audio chunk (" << chunkSize << " bytes) after " << ttfb << " ms." << endl;
+        }
+        else
+        {
+            cout << "Synthesizing event received with audio chunk of " << chunkSize << " bytes" << endl;
+        }
     };
 
-    synthesizer->SynthesisCompleted += [](const SpeechSynthesisEventArgs& e)
+    synthesizer->SynthesisCompleted += [&](const SpeechSynthesisEventArgs& e)
     {
-        UNUSED(e);
-        cout << "Synthesis completed." << endl;
+        auto now = chrono::steady_clock::now();
+        auto total = chrono::duration<double, milli>(now - requestSubmitted).count();
+        completionMillis.push_back(total);
+
+        // Streaming rate over the window from first byte to completion.
+        auto streamingWindow = chrono::duration<double>(now - firstChunkReceived).count();
+        if (firstChunkSeen && streamingWindow > 0)
+        {
+            streamingRates.push_back(requestBytes / streamingWindow / 1024.0);
+        }
+
+        if (MetricsWriter::Shared().Enabled())
+        {
+            MetricsWriter::Shared().Emit(e.Result->ResultId, "synthesis-completed", -1, -1, total);
+            return;
+        }
+        cout << "Synthesis completed: " << requestBytes << " bytes in " << total << " ms." << endl;
     };
 
     while (true)
@@ -591,6 +1013,11 @@ void SpeechSynthesisEvents()
             break;
         }
 
+        // Resets the per-request state and stamps submission.
+        firstChunkSeen = false;
+        requestBytes = 0;
+        requestSubmitted = chrono::steady_clock::now();
+
         auto result = synthesizer->SpeakTextAsync(text).get();
 
         // Checks result.
@@ -613,6 +1040,11 @@ void SpeechSynthesisEvents()
             }
         }
     }
+
+    // Prints the per-run percentile summary used for TTFB gating.
+    LatencyRecorder::PrintPercentiles("Time to first audio byte (ms)", ttfbMillis);
+    LatencyRecorder::PrintPercentiles("Request completion (ms)", completionMillis);
+    LatencyRecorder::PrintPercentiles("Streaming rate (KiB/s)", streamingRates);
 }
 
 // Speech synthesis word boundary event.
@@ -0,0 +1,103 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// An SSML document template, parsed once into literal segments and named
+// {placeholder} markers. Rendering substitutes values by appending into a
+// caller-provided buffer that is reused across items, so producing thousands
+// of documents from one template does no per-item string allocation beyond
+// the buffer's first growth.
+class SsmlTemplate final
+{
+public:
+
+    // Parses 'templateText', treating '{name}' spans as placeholders.
+    explicit SsmlTemplate(const std::string& templateText)
+    {
+        size_t position = 0;
+        while (position < templateText.size())
+        {
+            size_t open = templateText.find('{', position);
+            if (open == std::string::npos)
+            {
+                m_segments.push_back({ templateText.substr(position), "" });
+                break;
+            }
+
+            size_t close = templateText.find('}', open);
+            if (close == std::string::npos)
+            {
+                throw std::invalid_argument("Unterminated placeholder in SSML template.");
+            }
+
+            m_segments.push_back({ templateText.substr(position, open - position),
+                templateText.substr(open + 1, close - open - 1) });
+            position = close + 1;
+        }
+    }
+
+    // Renders the template into 'output', which is cleared first but keeps its
+    // capacity; pass the same string for every item to render allocation-free.
+    void RenderInto(std::string& output, const std::map<std::string, std::string>& values) const
+    {
+        output.clear();
+        for (const auto& segment : m_segments)
+        {
+            output += segment.literal;
+            if (!segment.placeholder.empty())
+            {
+                auto value = values.find(segment.placeholder);
+                if (value == values.end())
+                {
+                    throw std::invalid_argument("No value for SSML template placeholder '" + segment.placeholder + "'.");
+                }
+                output += value->second;
+            }
+        }
+    }
+
+private:
+    struct Segment
+    {
+        std::string literal;
+        std::string placeholder;
+    };
+
+    std::vector<Segment> m_segments;
+};
+
+// Process-wide cache of parsed SSML templates, so every worker shares one
+// parsed form per template instead of re-parsing per item or per thread.
+class SsmlTemplateCache final
+{
+public:
+
+    // Returns the parsed template registered under 'name', parsing
+    // 'templateText' only on the first request for that name.
+    static const SsmlTemplate& Get(const std::string& name, const std::string& templateText)
+    {
+        static SsmlTemplateCache cache;
+
+        std::lock_guard<std::mutex> lock(cache.m_mutex);
+        auto it = cache.m_templates.find(name);
+        if (it == cache.m_templates.end())
+        {
+            it = cache.m_templates.emplace(name, SsmlTemplate(templateText)).first;
+        }
+        return it->second;
+    }
+
+private:
+    SsmlTemplateCache() = default;
+
+    std::mutex m_mutex;
+    std::map<std::string, SsmlTemplate> m_templates;
+};
@@ -0,0 +1,101 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+// Process-wide counters on the audio stream boundary, cheap enough (relaxed
+// atomics) to leave on in production. They answer the question a slow session
+// always raises: are we starved by our own reader or throttled by the
+// service? Pull callbacks report time spent blocked inside Read(), push
+// feeders report bytes written, and the synthesis push callback reports its
+// accumulated queue depth. A background reporter prints one line per interval
+// with the deltas.
+class StreamCounters final
+{
+public:
+
+    static StreamCounters& Shared()
+    {
+        static StreamCounters counters;
+        return counters;
+    }
+
+    // Called by pull stream callbacks with the time one Read() call spent
+    // blocked (file I/O or waiting for the producer).
+    void AddReadBlocked(std::chrono::steady_clock::duration blocked)
+    {
+        m_readBlockedMicros.fetch_add(
+            std::chrono::duration_cast<std::chrono::microseconds>(blocked).count(),
+            std::memory_order_relaxed);
+    }
+
+    // Called by push stream feeders after each successful Write().
+    void AddBytesPushed(uint64_t bytes)
+    {
+        m_bytesPushed.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    // Called by the synthesis push output callback with its current
+    // accumulated (not yet consumed) byte count.
+    void SetSynthesisQueueBytes(uint64_t bytes)
+    {
+        m_synthesisQueueBytes.store(bytes, std::memory_order_relaxed);
+    }
+
+    // Starts the periodic one-line report; idempotent. The reporter prints
+    // interval deltas, so each line stands alone.
+    void StartPeriodicReport(std::chrono::seconds interval = std::chrono::seconds(5))
+    {
+        bool expected = false;
+        if (!m_reporting.compare_exchange_strong(expected, true))
+        {
+            return;
+        }
+        m_reporter = std::thread([this, interval]()
+        {
+            uint64_t lastBlockedMicros = m_readBlockedMicros.load(std::memory_order_relaxed);
+            uint64_t lastBytesPushed = m_bytesPushed.load(std::memory_order_relaxed);
+            while (m_reporting.load(std::memory_order_relaxed))
+            {
+                std::this_thread::sleep_for(interval);
+
+                uint64_t blockedMicros = m_readBlockedMicros.load(std::memory_order_relaxed);
+                uint64_t bytesPushed = m_bytesPushed.load(std::memory_order_relaxed);
+                double pushedKiBPerSec = (bytesPushed - lastBytesPushed) / 1024.0 / interval.count();
+
+                std::cout << "[stream] read-blocked " << (blockedMicros - lastBlockedMicros) / 1000.0
+                    << " ms, pushed " << (bytesPushed - lastBytesPushed) << " bytes ("
+                    << pushedKiBPerSec << " KiB/s), synth queue "
+                    << m_synthesisQueueBytes.load(std::memory_order_relaxed) << " bytes" << std::endl;
+
+                lastBlockedMicros = blockedMicros;
+                lastBytesPushed = bytesPushed;
+            }
+        });
+    }
+
+    // Stops the reporter; safe to call when it was never started.
+    void StopPeriodicReport()
+    {
+        if (m_reporting.exchange(false) && m_reporter.joinable())
+        {
+            m_reporter.join();
+        }
+    }
+
+private:
+    StreamCounters() = default;
+
+    std::atomic<uint64_t> m_readBlockedMicros{ 0 };
+    std::atomic<uint64_t> m_bytesPushed{ 0 };
+    std::atomic<uint64_t> m_synthesisQueueBytes{ 0 };
+    std::atomic<bool> m_reporting{ false };
+    std::thread m_reporter;
+};
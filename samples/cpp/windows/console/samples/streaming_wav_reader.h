@@ -4,50 +4,71 @@
 //
 #pragma once
 
-#include <speechapi_cxx.h>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
-
-// Helper functions
-class WavFileReader final
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// Reads wav audio from any std::istream, including non-seekable ones such as pipes
+// and sockets. Unlike WavFileReader, the header parser consumes unknown chunks by
+// reading them instead of seeking past them, so input like stdin can be fed straight
+// into a push stream with no staging copy to a temp file.
+class StreamingWavReader final
 {
 public:
 
-    // Constructor that creates an input stream from a file.
-    WavFileReader(const std::string& audioFileName)
+    // Constructor that reads the wav header from the given stream.
+    // The stream must remain valid for the lifetime of the reader.
+    StreamingWavReader(std::istream& stream)
+        : m_stream(stream)
     {
-        if (audioFileName.empty())
-        {
-            throw std::invalid_argument("Audio filename is empty");
-        }
-
-        std::ios_base::openmode mode = std::ios_base::binary | std::ios_base::in;
-        m_fs.open(audioFileName, mode);
-        if (!m_fs.good())
-        {
-            throw std::invalid_argument("Failed to open the specified audio file.");
-        }
+        // Get audio format from the stream header.
+        GetFormatFromWavStream();
+    }
 
-        // Get audio format from the file header.
-        GetFormatFromWavFile();
+    // Constructor that creates an input stream from a file.
+    StreamingWavReader(const std::string& audioFileName)
+        : m_ownedStream(OpenFile(audioFileName)), m_stream(*m_ownedStream)
+    {
+        // Get audio format from the stream header.
+        GetFormatFromWavStream();
     }
 
     int Read(uint8_t* dataBuffer, uint32_t size)
     {
-        if (m_fs.eof())
+        if (m_stream.eof())
             // returns 0 to indicate that the stream reaches end.
             return 0;
-        m_fs.read((char*)dataBuffer, size);
-        if (!m_fs.eof() && !m_fs.good())
+        m_stream.read((char*)dataBuffer, size);
+        if (!m_stream.eof() && !m_stream.good())
             // returns 0 to close the stream on read error.
             return 0;
         else
             // returns the number of bytes that have been read.
-            return (int)m_fs.gcount();
+            return (int)m_stream.gcount();
     }
 
     void Close()
     {
-        m_fs.close();
+        if (m_ownedStream != nullptr)
+        {
+            m_ownedStream->close();
+        }
+    }
+
+    // Gets the average byte rate parsed from the fmt chunk, for pacing calculations.
+    uint32_t GetAvgBytesPerSec() const
+    {
+        return m_formatHeader.AvgBytesPerSec;
+    }
+
+    // Gets the sample rate parsed from the fmt chunk.
+    uint32_t GetSamplesPerSec() const
+    {
+        return m_formatHeader.SamplesPerSec;
     }
 
 private:
@@ -56,49 +77,65 @@ private:
     static constexpr uint16_t chunkTypeBufferSize = 4;
     static constexpr uint16_t chunkSizeBufferSize = 4;
 
-    // Get format data from a wav file.
-    void GetFormatFromWavFile()
+    static std::unique_ptr<std::ifstream> OpenFile(const std::string& audioFileName)
+    {
+        if (audioFileName.empty())
+        {
+            throw std::invalid_argument("Audio filename is empty");
+        }
+
+        auto stream = std::make_unique<std::ifstream>(audioFileName, std::ios_base::binary | std::ios_base::in);
+        if (!stream->good())
+        {
+            throw std::invalid_argument("Failed to open the specified audio file.");
+        }
+        return stream;
+    }
+
+    // Get format data from the wav stream without seeking.
+    void GetFormatFromWavStream()
     {
         char tag[tagBufferSize];
         char chunkType[chunkTypeBufferSize];
         char chunkSizeBuffer[chunkSizeBufferSize];
         uint32_t chunkSize = 0;
 
-        // Set to throw exceptions when reading file header.
-        m_fs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        // Set to throw exceptions when reading the stream header.
+        auto originalExceptions = m_stream.exceptions();
+        m_stream.exceptions(std::istream::failbit | std::istream::badbit);
 
         try
         {
             // Checks the RIFF tag
-            m_fs.read(tag, tagBufferSize);
+            m_stream.read(tag, tagBufferSize);
             if (memcmp(tag, "RIFF", tagBufferSize) != 0)
             {
                 throw std::runtime_error("Invalid file header, tag 'RIFF' is expected.");
             }
 
             // The next is the RIFF chunk size, ignore now.
-            m_fs.read(chunkSizeBuffer, chunkSizeBufferSize);
+            m_stream.read(chunkSizeBuffer, chunkSizeBufferSize);
 
             // Checks the 'WAVE' tag in the wave header.
-            m_fs.read(chunkType, chunkTypeBufferSize);
+            m_stream.read(chunkType, chunkTypeBufferSize);
             if (memcmp(chunkType, "WAVE", chunkTypeBufferSize) != 0)
             {
                 throw std::runtime_error("Invalid file header, tag 'WAVE' is expected.");
             }
 
             bool foundDataChunk = false;
-            while (!foundDataChunk && m_fs.good() && !m_fs.eof())
+            while (!foundDataChunk && m_stream.good() && !m_stream.eof())
             {
                 ReadChunkTypeAndSize(chunkType, &chunkSize);
                 if (memcmp(chunkType, "fmt ", chunkTypeBufferSize) == 0)
                 {
                     // Reads format data.
-                    m_fs.read((char *)&m_formatHeader, sizeof(m_formatHeader));
+                    m_stream.read((char *)&m_formatHeader, sizeof(m_formatHeader));
 
-                    // Skips the rest of format data.
+                    // Consumes the rest of format data by reading, as the stream may not be seekable.
                     if (chunkSize > sizeof(m_formatHeader))
                     {
-                        m_fs.seekg(chunkSize - sizeof(m_formatHeader), std::ios_base::cur);
+                        DiscardBytes(chunkSize - sizeof(m_formatHeader));
                     }
                 }
                 else if (memcmp(chunkType, "data", chunkTypeBufferSize) == 0)
@@ -108,7 +145,8 @@ private:
                 }
                 else
                 {
-                    m_fs.seekg(chunkSize, std::ios_base::cur);
+                    // Consumes unknown chunks by reading instead of seeking.
+                    DiscardBytes(chunkSize);
                 }
             }
 
@@ -116,27 +154,27 @@ private:
             {
                 throw std::runtime_error("Did not find data chunk.");
             }
-            if (m_fs.eof() && chunkSize > 0)
+            if (m_stream.eof() && chunkSize > 0)
             {
                 throw std::runtime_error("Unexpected end of file, before any audio data can be read.");
             }
         }
-        catch (std::ifstream::failure e)
+        catch (std::istream::failure e)
         {
             throw std::runtime_error("Unexpected end of file or error when reading audio file.");
         }
         // Set to not throw exceptions when starting to read audio data
-        m_fs.exceptions(std::ifstream::goodbit);
+        m_stream.exceptions(originalExceptions);
     }
 
     void ReadChunkTypeAndSize(char* chunkType, uint32_t* chunkSize)
     {
         // Read the chunk type
-        m_fs.read(chunkType, chunkTypeBufferSize);
+        m_stream.read(chunkType, chunkTypeBufferSize);
 
         // Read the chunk size
         uint8_t chunkSizeBuffer[chunkSizeBufferSize];
-        m_fs.read((char*)chunkSizeBuffer, chunkSizeBufferSize);
+        m_stream.read((char*)chunkSizeBuffer, chunkSizeBufferSize);
 
         // chunk size is little endian
         *chunkSize = ((uint32_t)chunkSizeBuffer[3] << 24) |
@@ -145,6 +183,18 @@ private:
             (uint32_t)chunkSizeBuffer[0];
     }
 
+    // Reads and throws away 'count' bytes from the stream.
+    void DiscardBytes(uint32_t count)
+    {
+        char discardBuffer[256];
+        while (count > 0)
+        {
+            uint32_t toRead = count < sizeof(discardBuffer) ? count : (uint32_t)sizeof(discardBuffer);
+            m_stream.read(discardBuffer, toRead);
+            count -= toRead;
+        }
+    }
+
     // The format structure expected in wav files.
     struct WAVEFORMAT
     {
@@ -154,9 +204,10 @@ private:
         uint32_t AvgBytesPerSec;   // for buffer estimation.
         uint16_t BlockAlign;       // block size of data.
         uint16_t BitsPerSample;    // Number of bits per sample of mono data.
-    } m_formatHeader;
+    } m_formatHeader = {};
     static_assert(sizeof(m_formatHeader) == 16, "unexpected size of m_formatHeader");
 
 private:
-    std::fstream m_fs;
+    std::unique_ptr<std::ifstream> m_ownedStream;
+    std::istream& m_stream;
 };
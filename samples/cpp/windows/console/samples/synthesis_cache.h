@@ -0,0 +1,247 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Persistent cache for synthesized audio, keyed by voice, output format, and
+// a hash of the text or SSML. Each entry is a file in the cache directory
+// (named by the key hash) that is memory-mapped on first access; an in-memory
+// LRU index bounds how many mappings are held at once. Prompts that repeat —
+// the common case for IVR systems — are served straight from the mapping
+// without a synthesis round trip. Evicting an index entry only drops the
+// mapping; the file stays on disk and is remapped on the next request, so the
+// cache survives process restarts.
+class SynthesisCache final
+{
+public:
+
+    // 'cacheDirectory' must already exist; at most 'maxMappedEntries' entries
+    // are kept mapped at a time.
+    explicit SynthesisCache(const std::string& cacheDirectory, size_t maxMappedEntries = 256)
+        : m_cacheDirectory(cacheDirectory), m_maxMappedEntries(maxMappedEntries)
+    {
+        if (cacheDirectory.empty())
+        {
+            throw std::invalid_argument("Cache directory is empty");
+        }
+    }
+
+    ~SynthesisCache()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& entry : m_entries)
+        {
+            UnmapEntry(entry);
+        }
+    }
+
+    SynthesisCache(const SynthesisCache&) = delete;
+    SynthesisCache& operator=(const SynthesisCache&) = delete;
+
+    // Looks up the audio for the given voice/format/text. Returns a zero-copy
+    // pointer into the mapped store and its size, or false on a miss. The
+    // pointer stays valid until the entry is evicted, so consume it (or copy
+    // it) before issuing further cache calls.
+    bool TryGet(const std::string& voice, const std::string& format, const std::string& text,
+        const uint8_t** data, size_t* size)
+    {
+        uint64_t key = HashKey(voice, format, text);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto indexEntry = m_index.find(key);
+        if (indexEntry != m_index.end())
+        {
+            // Hit in the mapped index: move to the front of the LRU list.
+            m_entries.splice(m_entries.begin(), m_entries, indexEntry->second);
+            *data = m_entries.front().data;
+            *size = m_entries.front().size;
+            return true;
+        }
+
+        // Not mapped; the entry may still exist on disk from an earlier run.
+        return MapEntry(key, data, size);
+    }
+
+    // Stores the audio for the given voice/format/text, writing it to the
+    // on-disk store and mapping it into the index.
+    void Put(const std::string& voice, const std::string& format, const std::string& text,
+        const uint8_t* data, size_t size)
+    {
+        uint64_t key = HashKey(voice, format, text);
+
+        {
+            std::ofstream file(EntryPath(key), std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                throw std::runtime_error("Failed to write synthesis cache entry.");
+            }
+            file.write(reinterpret_cast<const char*>(data), size);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_index.find(key) == m_index.end())
+        {
+            const uint8_t* mappedData;
+            size_t mappedSize;
+            MapEntry(key, &mappedData, &mappedSize);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t key;
+        const uint8_t* data;
+        size_t size;
+#if defined(_WIN32)
+        HANDLE fileHandle;
+        HANDLE mappingHandle;
+#endif
+    };
+
+    // FNV-1a over the key components, with separators so ("ab","c") and
+    // ("a","bc") hash differently.
+    static uint64_t HashKey(const std::string& voice, const std::string& format, const std::string& text)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (const std::string* part : { &voice, &format, &text })
+        {
+            for (char c : *part)
+            {
+                hash = (hash ^ (uint8_t)c) * 1099511628211ULL;
+            }
+            hash = (hash ^ 0xFFu) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    std::string EntryPath(uint64_t key) const
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.raw", (unsigned long long)key);
+#if defined(_WIN32)
+        return m_cacheDirectory + "\\" + name;
+#else
+        return m_cacheDirectory + "/" + name;
+#endif
+    }
+
+    // Maps the on-disk entry for 'key' into the LRU index, evicting the least
+    // recently used mapping if the index is full. Returns false if no entry
+    // exists on disk. Must be called with the mutex held.
+    bool MapEntry(uint64_t key, const uint8_t** data, size_t* size)
+    {
+        Entry entry;
+        entry.key = key;
+        std::string path = EntryPath(key);
+
+#if defined(_WIN32)
+        entry.fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (entry.fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(entry.fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(entry.fileHandle);
+            return false;
+        }
+        entry.size = (size_t)fileSize.QuadPart;
+
+        entry.mappingHandle = CreateFileMappingA(entry.fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (entry.mappingHandle == nullptr)
+        {
+            CloseHandle(entry.fileHandle);
+            return false;
+        }
+
+        entry.data = (const uint8_t*)MapViewOfFile(entry.mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (entry.data == nullptr)
+        {
+            CloseHandle(entry.mappingHandle);
+            CloseHandle(entry.fileHandle);
+            return false;
+        }
+#else
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStat;
+        if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(fileDescriptor);
+            return false;
+        }
+        entry.size = (size_t)fileStat.st_size;
+
+        void* mapped = mmap(nullptr, entry.size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        close(fileDescriptor); // the mapping keeps its own reference.
+        if (mapped == MAP_FAILED)
+        {
+            return false;
+        }
+        entry.data = (const uint8_t*)mapped;
+#endif
+
+        if (m_entries.size() >= m_maxMappedEntries)
+        {
+            UnmapEntry(m_entries.back());
+            m_index.erase(m_entries.back().key);
+            m_entries.pop_back();
+        }
+
+        m_entries.push_front(entry);
+        m_index[key] = m_entries.begin();
+        *data = entry.data;
+        *size = entry.size;
+        return true;
+    }
+
+    static void UnmapEntry(Entry& entry)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(entry.data);
+        CloseHandle(entry.mappingHandle);
+        CloseHandle(entry.fileHandle);
+#else
+        munmap((void*)entry.data, entry.size);
+#endif
+    }
+
+private:
+    std::string m_cacheDirectory;
+    size_t m_maxMappedEntries;
+    std::mutex m_mutex;
+    std::list<Entry> m_entries;
+    std::map<uint64_t, std::list<Entry>::iterator> m_index;
+};
@@ -0,0 +1,281 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Thread placement policy for the multi-session drivers. On a multi-socket
+// host, feed and sink threads that migrate across NUMA nodes drag the cache
+// lines of their audio buffers along and pay cross-node memory traffic on
+// every chunk. The policy pins each session group's threads to an explicit
+// core set or to one NUMA node's cores; since the buffer pool and read arenas
+// allocate lazily on first use, first-touch then places their pages on the
+// node the pinned thread runs on, so the buffers stay node-local for the
+// lifetime of the run. Optionally tallies processed bytes per node so
+// cross-node imbalance is visible in the run report.
+//
+// Process-wide singleton like StreamCounters: the scenario runner configures
+// it from command-line flags and the batch drivers' worker threads consult it.
+// With no placement configured every call is a no-op.
+class ThreadPlacement final
+{
+public:
+
+    static ThreadPlacement& Shared()
+    {
+        static ThreadPlacement placement;
+        return placement;
+    }
+
+    // Restricts placement to an explicit core set, e.g. "0,2,8-11".
+    // Returns false when the list does not parse.
+    bool PinToCores(const std::string& coreList)
+    {
+        auto cores = ParseCoreList(coreList);
+        if (cores.empty())
+        {
+            return false;
+        }
+        m_cores = cores;
+        return true;
+    }
+
+    // Restricts placement to the cores of one NUMA node.
+    // Returns false when the node does not exist or has no cores.
+    bool PinToNode(int node)
+    {
+#if defined(_WIN32)
+        ULONGLONG processorMask = 0;
+        if (node < 0 || !GetNumaNodeProcessorMask((UCHAR)node, &processorMask) || processorMask == 0)
+        {
+            return false;
+        }
+        std::vector<int> cores;
+        for (int core = 0; core < 64; core++)
+        {
+            if (processorMask & (1ULL << core))
+            {
+                cores.push_back(core);
+            }
+        }
+        m_cores = cores;
+        return true;
+#else
+        std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string line;
+        if (!cpuList || !getline(cpuList, line))
+        {
+            return false;
+        }
+        auto cores = ParseCoreList(line);
+        if (cores.empty())
+        {
+            return false;
+        }
+        m_cores = cores;
+        return true;
+#endif
+    }
+
+    void EnableReport()
+    {
+        m_report = true;
+    }
+
+    bool ReportEnabled() const
+    {
+        return m_report;
+    }
+
+    // Pins the calling thread to one core of the configured set; threads with
+    // the same sessionIndex land on the same core, successive indices
+    // round-robin over the set. Call it first thing in each feed/sink/session
+    // thread, before the thread touches its buffers. No-op when no placement
+    // was configured.
+    void PinCurrentThread(size_t sessionIndex)
+    {
+        if (m_cores.empty())
+        {
+            return;
+        }
+        int core = m_cores[sessionIndex % m_cores.size()];
+#if defined(_WIN32)
+        SetThreadAffinityMask(GetCurrentThread(), 1ULL << core);
+#else
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(core, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#endif
+    }
+
+    // Attributes processed bytes to the NUMA node the calling thread is
+    // currently running on; feeds the per-node throughput report.
+    void AddBytes(uint64_t bytes)
+    {
+        if (!m_report)
+        {
+            return;
+        }
+        size_t node = CurrentNode();
+        if (node < m_nodeBytes.size())
+        {
+            m_nodeBytes[node].fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    // Prints bytes processed per node and each node's share of the total.
+    void PrintReport()
+    {
+        uint64_t total = 0;
+        for (const auto& nodeBytes : m_nodeBytes)
+        {
+            total += nodeBytes.load(std::memory_order_relaxed);
+        }
+        if (total == 0)
+        {
+            std::cout << "Placement report: no bytes attributed." << std::endl;
+            return;
+        }
+        std::ostringstream report;
+        report << "Placement report:";
+        for (size_t node = 0; node < m_nodeBytes.size(); node++)
+        {
+            uint64_t bytes = m_nodeBytes[node].load(std::memory_order_relaxed);
+            if (bytes != 0)
+            {
+                report << " node " << node << ": " << bytes << " bytes ("
+                    << (100.0 * bytes / total) << "%)";
+            }
+        }
+        std::cout << report.str() << std::endl;
+    }
+
+private:
+
+    ThreadPlacement()
+    {
+        for (auto& nodeBytes : m_nodeBytes)
+        {
+            nodeBytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Parses "0,2,8-11" into an explicit core list; the same format
+    // /sys/devices/system/node/nodeN/cpulist uses.
+    static std::vector<int> ParseCoreList(const std::string& coreList)
+    {
+        std::vector<int> cores;
+        std::istringstream input(coreList);
+        std::string token;
+        while (getline(input, token, ','))
+        {
+            try
+            {
+                auto dash = token.find('-');
+                if (dash == std::string::npos)
+                {
+                    cores.push_back(std::stoi(token));
+                }
+                else
+                {
+                    int first = std::stoi(token.substr(0, dash));
+                    int last = std::stoi(token.substr(dash + 1));
+                    for (int core = first; core <= last; core++)
+                    {
+                        cores.push_back(core);
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+                return {};
+            }
+        }
+        return cores;
+    }
+
+    // The NUMA node of the core the calling thread runs on right now.
+    static size_t CurrentNode()
+    {
+#if defined(_WIN32)
+        PROCESSOR_NUMBER processor;
+        USHORT node = 0;
+        GetCurrentProcessorNumberEx(&processor);
+        if (GetNumaProcessorNodeEx(&processor, &node))
+        {
+            return node;
+        }
+        return 0;
+#else
+        int core = sched_getcpu();
+        if (core < 0)
+        {
+            return 0;
+        }
+        return NodeOfCore(core);
+#endif
+    }
+
+#if !defined(_WIN32)
+    // Core-to-node lookup built once from sysfs; hosts without NUMA topology
+    // report everything as node 0.
+    static size_t NodeOfCore(int core)
+    {
+        static const std::vector<int> coreToNode = []()
+        {
+            std::vector<int> mapping;
+            for (int node = 0; ; node++)
+            {
+                std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                std::string line;
+                if (!cpuList || !getline(cpuList, line))
+                {
+                    break;
+                }
+                for (int nodeCore : ParseCoreList(line))
+                {
+                    if (nodeCore >= (int)mapping.size())
+                    {
+                        mapping.resize(nodeCore + 1, 0);
+                    }
+                    mapping[nodeCore] = node;
+                }
+            }
+            return mapping;
+        }();
+        if (core < (int)coreToNode.size())
+        {
+            return coreToNode[core];
+        }
+        return 0;
+    }
+#endif
+
+private:
+    std::vector<int> m_cores;
+    bool m_report = false;
+
+    // Per-node byte counters; more nodes than any host we drive has.
+    std::array<std::atomic<uint64_t>, 16> m_nodeBytes;
+};
@@ -0,0 +1,140 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "spsc_ring_buffer.h"
+
+// Buffered asynchronous transcript writer for Transcribing/Transcribed
+// handlers. The SDK callback thread formats each record (speaker id, offset,
+// text) and pushes it through a bounded lock-free ring; a writer thread
+// drains the ring in large batches and appends them to the file in one write.
+// The hot path therefore does no I/O and no locking, memory stays bounded,
+// and records that arrive while the ring is full are dropped and counted
+// rather than stalling the audio session.
+class AsyncTranscriptWriter final
+{
+public:
+
+    // 'queueBytes' bounds the formatted records buffered between the SDK
+    // callback thread and the writer thread.
+    explicit AsyncTranscriptWriter(const std::string& fileName, size_t queueBytes = 256 * 1024)
+        : m_ring(queueBytes),
+        m_file(fileName, std::ios::trunc),
+        m_worker(&AsyncTranscriptWriter::Drain, this)
+    {
+        if (!m_file)
+        {
+            throw std::invalid_argument("Cannot open transcript file '" + fileName + "' for writing.");
+        }
+    }
+
+    ~AsyncTranscriptWriter()
+    {
+        Close();
+    }
+
+    // Appends one transcript record. Must be called from a single thread (the
+    // SDK dispatches its events serially); the formatted record is written to
+    // the ring whole or dropped whole, never split.
+    void Append(const std::string& userId, uint64_t offsetTicks, const std::string& text)
+    {
+        m_record.clear();
+        m_record += userId;
+        m_record += '\t';
+        m_record += std::to_string(offsetTicks);
+        m_record += '\t';
+        m_record += text;
+        m_record += '\n';
+
+        // From the producer side ApproximateSize() never understates the fill
+        // level, so this check is conservative.
+        if (m_ring.Capacity() - m_ring.ApproximateSize() < m_record.size())
+        {
+            m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_ring.Write(reinterpret_cast<const uint8_t*>(m_record.data()), m_record.size());
+    }
+
+    // Waits until every queued record has reached the file; call this from
+    // the SessionStopped handler.
+    void Flush()
+    {
+        uint64_t completed = m_flushesCompleted.load(std::memory_order_acquire);
+        m_flushesRequested.fetch_add(1, std::memory_order_release);
+        while (m_flushesCompleted.load(std::memory_order_acquire) == completed)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Drains remaining records, stops the writer thread and closes the file.
+    void Close()
+    {
+        if (m_shutdown.exchange(true))
+        {
+            return;
+        }
+        m_worker.join();
+        m_file.close();
+
+        if (m_droppedRecords.load() > 0)
+        {
+            std::cout << "Transcript writer: dropped " << m_droppedRecords.load()
+                << " records because the queue was full." << std::endl;
+        }
+    }
+
+private:
+    void Drain()
+    {
+        std::vector<uint8_t> batch(64 * 1024);
+        while (true)
+        {
+            // Coalesces everything the producer has published into one append.
+            size_t bytes = m_ring.Read(batch.data(), batch.size());
+            if (bytes > 0)
+            {
+                m_file.write(reinterpret_cast<const char*>(batch.data()), bytes);
+                continue;
+            }
+
+            uint64_t requested = m_flushesRequested.load(std::memory_order_acquire);
+            if (m_flushesCompleted.load(std::memory_order_relaxed) < requested)
+            {
+                m_file.flush();
+                m_flushesCompleted.store(requested, std::memory_order_release);
+            }
+
+            if (m_shutdown.load(std::memory_order_acquire))
+            {
+                // One more read so records that raced with shutdown still land.
+                while ((bytes = m_ring.Read(batch.data(), batch.size())) > 0)
+                {
+                    m_file.write(reinterpret_cast<const char*>(batch.data()), bytes);
+                }
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+private:
+    SpscRingBuffer m_ring;
+    std::ofstream m_file;
+    std::string m_record;
+    std::atomic<bool> m_shutdown{ false };
+    std::atomic<uint64_t> m_droppedRecords{ 0 };
+    std::atomic<uint64_t> m_flushesRequested{ 0 };
+    std::atomic<uint64_t> m_flushesCompleted{ 0 };
+    std::thread m_worker;
+};
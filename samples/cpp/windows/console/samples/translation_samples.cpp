@@ -6,12 +6,28 @@
 #include "stdafx.h"
 
 // <toplevel>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
+#include <sstream>
 #include <speechapi_cxx.h>
+#include "audio_buffer_pool.h"
+#include "console_event_writer.h"
+#include "metrics_writer.h"
 
 using namespace std;
 using namespace Microsoft::CognitiveServices::Speech;
+using namespace Microsoft::CognitiveServices::Speech::Audio;
 using namespace Microsoft::CognitiveServices::Speech::Translation;
 // </toplevel>
 
@@ -77,6 +93,495 @@ void TranslationWithMicrophone()
     // </TranslationWithMicrophone>
 }
 
+// An audio egress sink for translated speech. Synthesizing-event chunks are
+// copied into fixed-size buffers leased from a pool and handed to a writer
+// thread, which appends them to the output file and returns each buffer to
+// the pool. Steady-state egress therefore reallocates nothing, unlike
+// accumulating the payload in one growing vector.
+class PooledAudioSink final
+{
+public:
+    explicit PooledAudioSink(const std::string& fileName)
+        : m_file(fileName, std::ios::binary),
+        m_worker(&PooledAudioSink::Drain, this)
+    {
+    }
+
+    ~PooledAudioSink()
+    {
+        Close();
+    }
+
+    // Slices 'size' bytes into pooled buffers and enqueues them for the
+    // writer; called on the SDK callback thread and never touches the file.
+    void Write(const uint8_t* data, size_t size)
+    {
+        while (size > 0)
+        {
+            auto buffer = m_pool.Acquire();
+            size_t filled = (std::min)(size, buffer.Size());
+            memcpy(buffer.Data(), data, filled);
+            data += filled;
+            size -= filled;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_pending.push_back({ std::move(buffer), filled });
+            m_available.notify_one();
+        }
+    }
+
+    // Drains outstanding buffers, stops the worker and closes the file.
+    void Close()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_shutdown)
+            {
+                return;
+            }
+            m_shutdown = true;
+            m_available.notify_one();
+        }
+        m_worker.join();
+        m_file.close();
+    }
+
+    uint64_t BytesWritten() const
+    {
+        return m_bytesWritten;
+    }
+
+private:
+    void Drain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_available.wait(lock, [this]() { return !m_pending.empty() || m_shutdown; });
+            if (m_pending.empty() && m_shutdown)
+            {
+                return;
+            }
+
+            auto chunk = std::move(m_pending.front());
+            m_pending.pop_front();
+            lock.unlock();
+
+            // The write happens outside the lock; destroying the lease after
+            // it returns the buffer to the pool for the next chunk.
+            m_file.write(reinterpret_cast<const char*>(chunk.buffer.Data()), chunk.filled);
+            m_bytesWritten += chunk.filled;
+
+            lock.lock();
+        }
+    }
+
+private:
+    struct Chunk
+    {
+        AudioBufferPool::Lease buffer;
+        size_t filled;
+    };
+
+    AudioBufferPool m_pool;
+    std::ofstream m_file;
+    std::mutex m_mutex;
+    std::condition_variable m_available;
+    std::deque<Chunk> m_pending;
+    bool m_shutdown = false;
+    uint64_t m_bytesWritten = 0;
+    std::thread m_worker;
+};
+
+// Speech-to-speech translation writing the synthesized audio through the pooled sink.
+void TranslationWithSpeechSynthesis()
+{
+    // Creates an instance of a speech translation config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechTranslationConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Sets source and target languages and requests synthesized translation audio.
+    auto fromLanguage = "en-US";
+    config->SetSpeechRecognitionLanguage(fromLanguage);
+    config->AddTargetLanguage("de");
+    config->SetVoiceName("de-DE-Hedda");
+
+    // Creates a translation recognizer using microphone as audio input.
+    auto recognizer = TranslationRecognizer::FromConfig(config);
+
+    // Synthesized audio chunks flow into pooled buffers and onto disk without
+    // per-chunk allocation or file I/O on the SDK callback thread.
+    PooledAudioSink audioSink("translationaudio.wav");
+    recognizer->Synthesizing.Connect([&audioSink](const TranslationSynthesisEventArgs& e)
+    {
+        const auto& audio = e.Result->Audio;
+        if (!audio.empty())
+        {
+            audioSink.Write(audio.data(), audio.size());
+        }
+    });
+
+    recognizer->Recognized.Connect([](const TranslationRecognitionEventArgs& e)
+    {
+        if (e.Result->Reason == ResultReason::TranslatedSpeech)
+        {
+            ConsoleEventWriter::Shared().Write("RECOGNIZED: Text=" + e.Result->Text);
+        }
+    });
+
+    recognizer->Canceled.Connect([](const TranslationRecognitionCanceledEventArgs& e)
+    {
+        cout << "CANCELED: Reason=" << (int)e.Reason << std::endl;
+        if (e.Reason == CancellationReason::Error)
+        {
+            cout << "CANCELED: ErrorCode=" << (int)e.ErrorCode << std::endl;
+            cout << "CANCELED: ErrorDetails=" << e.ErrorDetails << std::endl;
+            cout << "CANCELED: Did you update the subscription info?" << std::endl;
+        }
+    });
+
+    cout << "Say something...\n";
+
+    // Starts continuos recognition. Uses StopContinuousRecognitionAsync() to stop recognition.
+    recognizer->StartContinuousRecognitionAsync().get();
+
+    cout << "Press any key to stop\n";
+    string s;
+    getline(cin, s);
+
+    // Stops recognition.
+    recognizer->StopContinuousRecognitionAsync().get();
+
+    ConsoleEventWriter::Shared().Flush();
+    audioSink.Close();
+    cout << "Wrote " << audioSink.BytesWritten() << " bytes of translated audio to translationaudio.wav" << endl;
+}
+
+// A per-target-language result sink: translations are enqueued from the SDK
+// callback thread without blocking and drained to the language's own output
+// file by a dedicated worker, so one slow sink can never backpressure the
+// audio session. Each record carries its enqueue timestamp; Close() reports
+// how far the sink lagged behind translation arrival.
+class TranslationLanguageSink final
+{
+public:
+    explicit TranslationLanguageSink(const std::string& language)
+        : m_language(language),
+        m_file("translations_" + language + ".txt"),
+        m_worker(&TranslationLanguageSink::Drain, this)
+    {
+    }
+
+    ~TranslationLanguageSink()
+    {
+        Close();
+    }
+
+    // Enqueues one translated utterance; called on the SDK callback thread.
+    void Write(const std::string& text)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_pending.push_back({ std::chrono::steady_clock::now(), text });
+        m_available.notify_one();
+    }
+
+    // Drains remaining records, stops the worker and reports sink lag.
+    void Close()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_shutdown)
+            {
+                return;
+            }
+            m_shutdown = true;
+            m_available.notify_one();
+        }
+        m_worker.join();
+
+        std::cout << "Language '" << m_language << "': " << m_recordsWritten << " translations, "
+            << "avg sink lag " << (m_recordsWritten == 0 ? 0.0 : m_totalLagMillis / m_recordsWritten)
+            << " ms, max " << m_maxLagMillis << " ms." << std::endl;
+    }
+
+private:
+    void Drain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_available.wait(lock, [this]() { return !m_pending.empty() || m_shutdown; });
+            if (m_pending.empty() && m_shutdown)
+            {
+                return;
+            }
+
+            auto record = std::move(m_pending.front());
+            m_pending.pop_front();
+            lock.unlock();
+
+            // File I/O happens outside the lock, so enqueueing never waits on it.
+            auto lagMillis = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - record.enqueued).count();
+            m_totalLagMillis += lagMillis;
+            m_maxLagMillis = std::max(m_maxLagMillis, lagMillis);
+            m_recordsWritten++;
+            m_file << record.text << '\n';
+
+            lock.lock();
+        }
+    }
+
+private:
+    struct Record
+    {
+        std::chrono::steady_clock::time_point enqueued;
+        std::string text;
+    };
+
+    std::string m_language;
+    std::ofstream m_file;
+    std::mutex m_mutex;
+    std::condition_variable m_available;
+    std::deque<Record> m_pending;
+    bool m_shutdown = false;
+    uint64_t m_recordsWritten = 0;
+    double m_totalLagMillis = 0;
+    double m_maxLagMillis = 0;
+    std::thread m_worker;
+};
+
+// Continuous translation into many target languages with per-language sinks.
+void TranslationMultiTargetContinuousRecognition()
+{
+    // Creates an instance of a speech translation config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechTranslationConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Sets the source language and a wide fan-out of target languages.
+    auto fromLanguage = "en-US";
+    config->SetSpeechRecognitionLanguage(fromLanguage);
+    vector<string> targetLanguages { "de", "fr", "es", "it", "ja", "ko", "pt", "zh-Hans" };
+
+    // One sink per target language, each with its own output file and drain thread.
+    map<string, unique_ptr<TranslationLanguageSink>> sinks;
+    for (const auto& language : targetLanguages)
+    {
+        config->AddTargetLanguage(language);
+        sinks[language] = make_unique<TranslationLanguageSink>(language);
+    }
+
+    // Creates a translation recognizer using microphone as audio input.
+    auto recognizer = TranslationRecognizer::FromConfig(config);
+
+    // Subscribes to events. The handler only routes each translation to its
+    // language's queue; all file writing happens on the sink workers.
+    recognizer->Recognized.Connect([&sinks](const TranslationRecognitionEventArgs& e)
+    {
+        if (e.Result->Reason == ResultReason::TranslatedSpeech)
+        {
+            for (const auto& it : e.Result->Translations)
+            {
+                auto sink = sinks.find(it.first);
+                if (sink != sinks.end())
+                {
+                    sink->second->Write(it.second);
+                }
+            }
+            ConsoleEventWriter::Shared().Write("RECOGNIZED: Text=" + e.Result->Text);
+        }
+    });
+
+    recognizer->Canceled.Connect([](const TranslationRecognitionCanceledEventArgs& e)
+    {
+        cout << "CANCELED: Reason=" << (int)e.Reason << std::endl;
+        if (e.Reason == CancellationReason::Error)
+        {
+            cout << "CANCELED: ErrorCode=" << (int)e.ErrorCode << std::endl;
+            cout << "CANCELED: ErrorDetails=" << e.ErrorDetails << std::endl;
+            cout << "CANCELED: Did you update the subscription info?" << std::endl;
+        }
+    });
+
+    cout << "Say something...\n";
+
+    // Starts continuos recognition. Uses StopContinuousRecognitionAsync() to stop recognition.
+    recognizer->StartContinuousRecognitionAsync().get();
+
+    cout << "Press any key to stop\n";
+    string s;
+    getline(cin, s);
+
+    // Stops recognition.
+    recognizer->StopContinuousRecognitionAsync().get();
+
+    // Makes sure all queued event output reaches the terminal and each sink
+    // finishes its file before reporting per-language lag.
+    ConsoleEventWriter::Shared().Flush();
+    for (auto& sink : sinks)
+    {
+        sink.second->Close();
+    }
+}
+
+// Continuous translation streaming a compressed container (MP3/Opus/FLAC)
+// directly into the recognizer. The SDK decodes the container in-process
+// behind AudioStreamFormat::GetCompressedFormat(), so the job reads the
+// compressed bytes once instead of decoding to an intermediate wav file on
+// disk first.
+void TranslationContinuousRecognitionFromCompressedFile()
+{
+    // Creates an instance of a speech translation config with specified subscription key and service region.
+    // Replace with your own subscription key and service region (e.g., "westus").
+    auto config = SpeechTranslationConfig::FromSubscription("YourSubscriptionKey", "YourServiceRegion");
+
+    // Sets source and target languages
+    auto fromLanguage = "en-US";
+    config->SetSpeechRecognitionLanguage(fromLanguage);
+    config->AddTargetLanguage("de");
+    config->AddTargetLanguage("fr");
+
+    // Replace with your own compressed audio file. The container is selected
+    // from the extension; raw a-law/mu-law has no header and only works this way.
+    const string compressedFileName = "YourCompressedAudioFile.mp3";
+
+    auto hasExtension = [&compressedFileName](const char* extension)
+    {
+        size_t length = strlen(extension);
+        return compressedFileName.size() >= length
+            && compressedFileName.compare(compressedFileName.size() - length, length, extension) == 0;
+    };
+
+    AudioStreamContainerFormat containerFormat;
+    if (hasExtension(".mp3"))
+    {
+        containerFormat = AudioStreamContainerFormat::MP3;
+    }
+    else if (hasExtension(".opus"))
+    {
+        containerFormat = AudioStreamContainerFormat::OGG_OPUS;
+    }
+    else if (hasExtension(".flac"))
+    {
+        containerFormat = AudioStreamContainerFormat::FLAC;
+    }
+    else if (hasExtension(".alaw"))
+    {
+        containerFormat = AudioStreamContainerFormat::ALAW;
+    }
+    else if (hasExtension(".mulaw"))
+    {
+        containerFormat = AudioStreamContainerFormat::MULAW;
+    }
+    else
+    {
+        cout << "Unable to select the input container from the extension of " << compressedFileName << std::endl;
+        return;
+    }
+
+    // Serves the SDK's pull callback straight from the compressed file. The
+    // bytes are opaque container data; the decoder pulls them at its own pace,
+    // so no pacing or parsing is needed here.
+    class CompressedFileCallback final : public PullAudioInputStreamCallback
+    {
+    public:
+        explicit CompressedFileCallback(const string& fileName)
+            : m_file(fileName, ios::binary)
+        {
+        }
+
+        bool IsOpen() const
+        {
+            return m_file.is_open();
+        }
+
+        int Read(uint8_t* dataBuffer, uint32_t size) override
+        {
+            m_file.read(reinterpret_cast<char*>(dataBuffer), size);
+            return (int)m_file.gcount();
+        }
+
+        void Close() override
+        {
+            m_file.close();
+        }
+
+    private:
+        ifstream m_file;
+    };
+
+    auto callback = make_shared<CompressedFileCallback>(compressedFileName);
+    if (!callback->IsOpen())
+    {
+        cout << "Could not open the compressed audio file " << compressedFileName << std::endl;
+        return;
+    }
+
+    // Creates a translation recognizer pulling the compressed bytes directly.
+    auto pullStream = AudioInputStream::CreatePullStream(
+        AudioStreamFormat::GetCompressedFormat(containerFormat), callback);
+    auto audioInput = AudioConfig::FromStreamInput(pullStream);
+    auto recognizer = TranslationRecognizer::FromConfig(config, audioInput);
+
+    // Promise for synchronization of recognition end.
+    promise<void> recognitionEnd;
+
+    // Subscribes to events. Handlers enqueue records for the shared console
+    // writer instead of blocking the SDK's dispatch thread on terminal I/O.
+    recognizer->Recognized.Connect([](const TranslationRecognitionEventArgs& e)
+    {
+        if (e.Result->Reason == ResultReason::TranslatedSpeech)
+        {
+            ostringstream record;
+            record << "RECOGNIZED: Text=" << e.Result->Text;
+            for (const auto& it : e.Result->Translations)
+            {
+                record << "\n  Translated into '" << it.first.c_str() << "': " << it.second.c_str();
+            }
+            ConsoleEventWriter::Shared().Write(record.str());
+        }
+        else if (e.Result->Reason == ResultReason::NoMatch)
+        {
+            ConsoleEventWriter::Shared().Write("NOMATCH: Speech could not be recognized.");
+        }
+    });
+
+    recognizer->Canceled.Connect([&recognitionEnd](const TranslationRecognitionCanceledEventArgs& e)
+    {
+        if (e.Reason == CancellationReason::Error)
+        {
+            cout << "CANCELED: ErrorCode=" << (int)e.ErrorCode << std::endl;
+            cout << "CANCELED: ErrorDetails=" << e.ErrorDetails << std::endl;
+            cout << "CANCELED: Did you update the subscription info?" << std::endl;
+            recognitionEnd.set_value();
+        }
+    });
+
+    recognizer->SessionStopped.Connect([&recognitionEnd](const SessionEventArgs& e)
+    {
+        cout << "Session stopped. Id = " << e.SessionId << std::endl;
+        recognitionEnd.set_value();
+    });
+
+    auto translationStart = chrono::steady_clock::now();
+
+    // Starts continuous recognition; the session ends by itself when the
+    // decoder reaches the end of the compressed file.
+    recognizer->StartContinuousRecognitionAsync().get();
+
+    // Waits for recognition end.
+    recognitionEnd.get_future().get();
+
+    // Stops recognition.
+    recognizer->StopContinuousRecognitionAsync().get();
+
+    // Makes sure all queued event output reaches the terminal.
+    ConsoleEventWriter::Shared().Flush();
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - translationStart);
+    cout << "Translated " << compressedFileName << " in " << elapsed.count() << " ms." << std::endl;
+}
+
 // Continuous translation.
 void TranslationContinuousRecognition()
 {
@@ -93,35 +598,50 @@ void TranslationContinuousRecognition()
     // Creates a translation recognizer using microphone as audio input.
     auto recognizer = TranslationRecognizer::FromConfig(config);
 
-    // Subscribes to events.
+    // Subscribes to events. Handlers enqueue records for the shared console
+    // writer instead of blocking the SDK's dispatch thread on terminal I/O.
     recognizer->Recognizing.Connect([](const TranslationRecognitionEventArgs& e)
     {
-        cout << "Recognizing:" << e.Result->Text << std::endl;
+        if (MetricsWriter::Shared().Enabled())
+        {
+            MetricsWriter::Shared().Emit(e.SessionId, "translating", e.Result->Offset());
+            return;
+        }
+        ostringstream record;
+        record << "Recognizing:" << e.Result->Text;
         for (const auto& it : e.Result->Translations)
         {
-            cout << "  Translated into '" << it.first.c_str() << "': " << it.second.c_str() << std::endl;
+            record << "\n  Translated into '" << it.first.c_str() << "': " << it.second.c_str();
         }
+        ConsoleEventWriter::Shared().Write(record.str());
     });
 
     recognizer->Recognized.Connect([](const TranslationRecognitionEventArgs& e)
     {
+        if (MetricsWriter::Shared().Enabled())
+        {
+            MetricsWriter::Shared().Emit(e.SessionId, "translated", e.Result->Offset(), e.Result->Duration());
+            return;
+        }
+        ostringstream record;
         if (e.Result->Reason == ResultReason::TranslatedSpeech)
         {
-            cout << "RECOGNIZED: Text=" << e.Result->Text << std::endl;
+            record << "RECOGNIZED: Text=" << e.Result->Text;
         }
         else if (e.Result->Reason == ResultReason::RecognizedSpeech)
         {
-            cout << "RECOGNIZED: Text=" << e.Result->Text << " (text could not be translated)" << std::endl;
+            record << "RECOGNIZED: Text=" << e.Result->Text << " (text could not be translated)";
         }
         else if (e.Result->Reason == ResultReason::NoMatch)
         {
-            cout << "NOMATCH: Speech could not be recognized." << std::endl;
+            record << "NOMATCH: Speech could not be recognized.";
         }
 
         for (const auto& it : e.Result->Translations)
         {
-            cout << "  Translated into '" << it.first.c_str() << "': " << it.second.c_str() << std::endl;
+            record << "\n  Translated into '" << it.first.c_str() << "': " << it.second.c_str();
         }
+        ConsoleEventWriter::Shared().Write(record.str());
     });
 
     recognizer->Canceled.Connect([](const TranslationRecognitionCanceledEventArgs& e)
@@ -153,4 +673,7 @@ void TranslationContinuousRecognition()
 
     // Stops recognition.
     recognizer->StopContinuousRecognitionAsync().get();
+
+    // Makes sure all queued event output reaches the terminal.
+    ConsoleEventWriter::Shared().Flush();
 }
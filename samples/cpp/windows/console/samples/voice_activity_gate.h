@@ -0,0 +1,135 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define VOICE_ACTIVITY_GATE_USE_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define VOICE_ACTIVITY_GATE_USE_NEON 1
+#endif
+
+// Energy-based voice activity gate for push-stream feeders. Long silences in
+// the input cost service time and uplink bandwidth; the gate computes the mean
+// sample energy of each chunk with a vectorized int16 kernel and tells the
+// feeder to skip chunks below the threshold. A hangover keeps a few chunks
+// streaming after energy drops so utterance tails are not clipped, and because
+// the first sub-threshold chunks within the hangover still stream, speech
+// onsets following short pauses are preserved as well. Counters report how
+// many bytes were suppressed.
+//
+// Note that skipping audio compresses the service-side timeline: Offset()
+// values of results no longer match positions in the original file.
+class VoiceActivityGate final
+{
+public:
+
+    // 'energyThreshold' is the root-mean-square amplitude (0..32767) below which
+    // a chunk counts as silence; 'hangoverChunks' is how many sub-threshold
+    // chunks keep streaming after the last active one.
+    VoiceActivityGate(uint32_t energyThreshold = 300, uint32_t hangoverChunks = 5)
+        : m_squaredThreshold((uint64_t)energyThreshold * energyThreshold),
+          m_hangoverChunks(hangoverChunks)
+    {
+    }
+
+    // Decides whether a chunk of 16-bit PCM should be streamed. Returns true to
+    // stream it, false to suppress it. 'bytes' must be even.
+    bool Accept(const uint8_t* data, size_t bytes)
+    {
+        size_t samples = bytes / 2;
+        if (samples == 0)
+        {
+            return false;
+        }
+
+        uint64_t meanSquare = SumOfSquares(reinterpret_cast<const int16_t*>(data), samples) / samples;
+        if (meanSquare >= m_squaredThreshold)
+        {
+            m_remainingHangover = m_hangoverChunks;
+            m_bytesStreamed += bytes;
+            return true;
+        }
+
+        if (m_remainingHangover > 0)
+        {
+            m_remainingHangover--;
+            m_bytesStreamed += bytes;
+            return true;
+        }
+
+        m_bytesSuppressed += bytes;
+        return false;
+    }
+
+    uint64_t BytesStreamed() const { return m_bytesStreamed; }
+
+    uint64_t BytesSuppressed() const { return m_bytesSuppressed; }
+
+    // Prints how much of the input the gate kept off the wire.
+    void PrintSummary() const
+    {
+        uint64_t total = m_bytesStreamed + m_bytesSuppressed;
+        std::cout << "Voice activity gate: suppressed " << m_bytesSuppressed << " of " << total << " bytes";
+        if (total > 0)
+        {
+            std::cout << " (" << (100 * m_bytesSuppressed / total) << "%)";
+        }
+        std::cout << std::endl;
+    }
+
+private:
+
+    // Sum of squared samples, vectorized where available. Pairwise int16
+    // products fit in int32 (2 * 32767^2 < 2^31), and the pairwise sums are
+    // widened to 64 bits before accumulation so long chunks cannot overflow.
+    static uint64_t SumOfSquares(const int16_t* samples, size_t count)
+    {
+        uint64_t sum = 0;
+        size_t i = 0;
+#if defined(VOICE_ACTIVITY_GATE_USE_SSE2)
+        __m128i zero = _mm_setzero_si128();
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+            __m128i squares = _mm_madd_epi16(v, v);
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(squares, zero));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(squares, zero));
+        }
+        uint64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        sum = lanes[0] + lanes[1];
+#elif defined(VOICE_ACTIVITY_GATE_USE_NEON)
+        int64x2_t acc = vdupq_n_s64(0);
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t v = vld1q_s16(samples + i);
+            int32x4_t low = vmull_s16(vget_low_s16(v), vget_low_s16(v));
+            int32x4_t high = vmull_s16(vget_high_s16(v), vget_high_s16(v));
+            acc = vpadalq_s32(acc, low);
+            acc = vpadalq_s32(acc, high);
+        }
+        sum = (uint64_t)(vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1));
+#endif
+        for (; i < count; i++)
+        {
+            sum += (int32_t)samples[i] * samples[i];
+        }
+        return sum;
+    }
+
+private:
+    uint64_t m_squaredThreshold;
+    uint32_t m_hangoverChunks;
+    uint32_t m_remainingHangover = 0;
+    uint64_t m_bytesStreamed = 0;
+    uint64_t m_bytesSuppressed = 0;
+};
@@ -0,0 +1,89 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <speechapi_cxx.h>
+
+// Disk-backed store of enrolled voice profile ids, keyed by speaker. Profile
+// creation and enrollment are the slow part of speaker recognition startup;
+// persisting the profile id lets later runs rehydrate the profile and verify
+// it is still enrolled with a single RetrieveEnrollmentResultAsync round trip
+// instead of re-enrolling from audio. Entries that turn out deleted or only
+// partially enrolled on the service side are dropped so the caller re-enrolls.
+class VoiceProfileStore final
+{
+public:
+
+    // Loads the store from 'storeFileName' (one "speaker<TAB>profileId" line
+    // per entry); a missing file is an empty store.
+    explicit VoiceProfileStore(const std::string& storeFileName)
+        : m_storeFileName(storeFileName)
+    {
+        std::ifstream file(storeFileName);
+        std::string line;
+        while (getline(file, line))
+        {
+            size_t separator = line.find('\t');
+            if (separator != std::string::npos)
+            {
+                m_profileIds[line.substr(0, separator)] = line.substr(separator + 1);
+            }
+        }
+    }
+
+    // Returns the stored profile for 'speakerKey' after confirming it is still
+    // enrolled on the service, or nullptr when the caller needs to enroll.
+    std::shared_ptr<Microsoft::CognitiveServices::Speech::VoiceProfile> TryGet(
+        const std::shared_ptr<Microsoft::CognitiveServices::Speech::VoiceProfileClient>& client,
+        const std::string& speakerKey)
+    {
+        using namespace Microsoft::CognitiveServices::Speech;
+
+        auto it = m_profileIds.find(speakerKey);
+        if (it == m_profileIds.end())
+        {
+            return nullptr;
+        }
+
+        // Rehydrates the profile from its id and checks its enrollment state.
+        auto profile = VoiceProfile::FromId(it->second);
+        auto enrollment = client->RetrieveEnrollmentResultAsync(profile).get();
+        if (enrollment->Reason == ResultReason::EnrolledVoiceProfile)
+        {
+            return profile;
+        }
+
+        // The profile is gone or not fully enrolled; forget it and re-enroll.
+        m_profileIds.erase(it);
+        Save();
+        return nullptr;
+    }
+
+    // Records the enrolled profile for 'speakerKey' and persists the store.
+    void Put(const std::string& speakerKey,
+        const std::shared_ptr<Microsoft::CognitiveServices::Speech::VoiceProfile>& profile)
+    {
+        m_profileIds[speakerKey] = profile->GetId();
+        Save();
+    }
+
+private:
+    void Save()
+    {
+        std::ofstream file(m_storeFileName, std::ios::trunc);
+        for (const auto& entry : m_profileIds)
+        {
+            file << entry.first << '\t' << entry.second << '\n';
+        }
+    }
+
+private:
+    std::string m_storeFileName;
+    std::map<std::string, std::string> m_profileIds;
+};
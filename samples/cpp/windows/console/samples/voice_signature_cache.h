@@ -0,0 +1,95 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Disk cache of conversation-transcription voice signatures. Generating a
+// signature means a REST call per speaker, which dominates meeting-join time
+// for rotating rosters; this store keys each signature by the speaker id and
+// a hash of their enrollment audio, so known speakers load in milliseconds
+// and the endpoint is only hit when a speaker is new or re-recorded their
+// enrollment audio.
+class VoiceSignatureCache final
+{
+public:
+
+    explicit VoiceSignatureCache(const std::string& cacheDirectory)
+        : m_cacheDirectory(cacheDirectory)
+    {
+    }
+
+    // Returns the cached signature for 'speaker', or invokes 'generator' (the
+    // signature REST call) and caches its result. A changed enrollment audio
+    // file changes the key, so stale signatures are regenerated automatically.
+    std::string GetOrCreate(const std::string& speaker, const std::string& enrollmentAudioFileName,
+        const std::function<std::string()>& generator)
+    {
+        auto path = EntryPath(HashKey(speaker, enrollmentAudioFileName));
+
+        std::ifstream cached(path, std::ios::binary);
+        if (cached)
+        {
+            return std::string((std::istreambuf_iterator<char>(cached)), std::istreambuf_iterator<char>());
+        }
+
+        auto signature = generator();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(signature.data(), signature.size());
+        return signature;
+    }
+
+private:
+
+    // FNV-1a over the speaker id and the enrollment audio bytes, with a
+    // separator that cannot occur in either part. When the audio file cannot
+    // be read, its name stands in so the sample still runs without it.
+    static uint64_t HashKey(const std::string& speaker, const std::string& enrollmentAudioFileName)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const char* data, size_t size)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= (uint8_t)data[i];
+                hash *= 1099511628211ull;
+            }
+            hash ^= 0xFF;
+            hash *= 1099511628211ull;
+        };
+
+        mix(speaker.data(), speaker.size());
+
+        std::ifstream audio(enrollmentAudioFileName, std::ios::binary);
+        if (audio)
+        {
+            char buffer[64 * 1024];
+            while (audio.read(buffer, sizeof(buffer)).gcount() > 0)
+            {
+                mix(buffer, (size_t)audio.gcount());
+            }
+        }
+        else
+        {
+            mix(enrollmentAudioFileName.data(), enrollmentAudioFileName.size());
+        }
+        return hash;
+    }
+
+    std::string EntryPath(uint64_t key) const
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "voicesig_%016llx.json", (unsigned long long)key);
+        return m_cacheDirectory + "/" + name;
+    }
+
+private:
+    std::string m_cacheDirectory;
+};
@@ -7,6 +7,23 @@
 #import <AVFoundation/AVFoundation.h>
 #import <MicrosoftCognitiveServicesSpeech/SPXSpeechApi.h>
 
+// Lazy GStreamer plugin registration exported by GStreamerWrapper
+// (gstreamer_modules.h; redeclared here because that header pulls in the
+// GStreamer SDK). Registering the selected container's chain before the
+// Speech SDK initializes GStreamer means only that codec is loaded, instead
+// of every static plugin at startup.
+typedef enum spx_gst_container_format
+{
+    SPX_GST_CONTAINER_ANY = 0,
+    SPX_GST_CONTAINER_MP3 = 1,
+    SPX_GST_CONTAINER_OGG_OPUS = 2,
+    SPX_GST_CONTAINER_FLAC = 3,
+    SPX_GST_CONTAINER_ALAW = 4,
+    SPX_GST_CONTAINER_MULAW = 5,
+    SPX_GST_CONTAINER_WAV = 6,
+} spx_gst_container_format;
+extern void spx_gst_register_container(spx_gst_container_format format);
+
 
 @interface ViewController () {
     NSString *speechKey;
@@ -65,6 +82,10 @@
 
     // <setup-stream>
     SPXAudioStreamContainerFormat compressedStreamFormat = SPXAudioStreamContainerFormat_MP3;
+
+    // Registers only the MP3 decode chain; the Opus/FLAC/a-law/mu-law plugins
+    // never load, cutting cold launch and resident footprint.
+    spx_gst_register_container(SPX_GST_CONTAINER_MP3);
     SPXAudioStreamFormat *audioFormat = [[SPXAudioStreamFormat alloc] initUsingCompressedFormat:compressedStreamFormat];
     SPXPushAudioInputStream* stream = [[SPXPushAudioInputStream alloc] initWithAudioFormat:audioFormat];
 
@@ -7,6 +7,134 @@
 
 #include "gstreamer_modules.h"
 
+#include <atomic>
+#include <mutex>
+
+#if defined(TARGET_OS_IPHONE)
+namespace {
+
+// Set once the app selects a container; spx_gst_init then skips the eager
+// register-everything fallback.
+std::atomic<bool> s_containerSelected{ false };
+
+// Each chain registers at most once however often a format is selected;
+// call_once also makes concurrent selection from different threads safe.
+
+void RegisterBase()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+    {
+        // Elements every decode pipeline needs regardless of codec.
+        GST_PLUGIN_STATIC_REGISTER(coreelements);
+        GST_PLUGIN_STATIC_REGISTER(app);
+        GST_PLUGIN_STATIC_REGISTER(audioconvert);
+        GST_PLUGIN_STATIC_REGISTER(audioresample);
+    });
+}
+
+void RegisterMp3()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+    {
+        // audioparsers carries mpegaudioparse; mpg123 decodes.
+        GST_PLUGIN_STATIC_REGISTER(audioparsers);
+        GST_PLUGIN_STATIC_REGISTER(mpg123);
+    });
+}
+
+void RegisterOpus()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+    {
+        GST_PLUGIN_STATIC_REGISTER(ogg);
+        GST_PLUGIN_STATIC_REGISTER(opusparse);
+        GST_PLUGIN_STATIC_REGISTER(opus);
+    });
+}
+
+void RegisterFlac()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+    {
+        GST_PLUGIN_STATIC_REGISTER(audioparsers);
+        GST_PLUGIN_STATIC_REGISTER(flac);
+    });
+}
+
+void RegisterAlaw()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+    {
+        GST_PLUGIN_STATIC_REGISTER(alaw);
+    });
+}
+
+void RegisterMulaw()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+    {
+        GST_PLUGIN_STATIC_REGISTER(mulaw);
+    });
+}
+
+void RegisterWav()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+    {
+        GST_PLUGIN_STATIC_REGISTER(wavparse);
+    });
+}
+
+} // namespace
+#endif
+
+extern "C" void spx_gst_register_container(spx_gst_container_format format)
+{
+#if defined(TARGET_OS_IPHONE)
+    s_containerSelected.store(true);
+    RegisterBase();
+    switch (format)
+    {
+    case SPX_GST_CONTAINER_MP3:
+        RegisterMp3();
+        break;
+    case SPX_GST_CONTAINER_OGG_OPUS:
+        RegisterOpus();
+        break;
+    case SPX_GST_CONTAINER_FLAC:
+        RegisterFlac();
+        break;
+    case SPX_GST_CONTAINER_ALAW:
+        RegisterAlaw();
+        break;
+    case SPX_GST_CONTAINER_MULAW:
+        RegisterMulaw();
+        break;
+    case SPX_GST_CONTAINER_WAV:
+        RegisterWav();
+        break;
+    case SPX_GST_CONTAINER_ANY:
+    default:
+        RegisterMp3();
+        RegisterOpus();
+        RegisterFlac();
+        RegisterAlaw();
+        RegisterMulaw();
+        RegisterWav();
+        break;
+    }
+#else
+    (void)format;
+#endif
+}
+
 namespace Microsoft {
 namespace CognitiveServices {
 namespace Speech {
@@ -14,19 +142,17 @@ namespace Impl {
 
 void spx_gst_init() {
 #if defined(TARGET_OS_IPHONE)
-    GST_PLUGIN_STATIC_REGISTER(coreelements);
-    GST_PLUGIN_STATIC_REGISTER(app);
-    GST_PLUGIN_STATIC_REGISTER(audioconvert);
-    GST_PLUGIN_STATIC_REGISTER(mpg123);
-    GST_PLUGIN_STATIC_REGISTER(audioresample);
-    GST_PLUGIN_STATIC_REGISTER(audioparsers);
-    GST_PLUGIN_STATIC_REGISTER(ogg);
-    GST_PLUGIN_STATIC_REGISTER(opusparse);
-    GST_PLUGIN_STATIC_REGISTER(opus);
-    GST_PLUGIN_STATIC_REGISTER(wavparse);
-    GST_PLUGIN_STATIC_REGISTER(alaw);
-    GST_PLUGIN_STATIC_REGISTER(mulaw);
-    GST_PLUGIN_STATIC_REGISTER(flac);
+    if (s_containerSelected.load())
+    {
+        // The app already registered its container's chain; only make sure
+        // the base elements are in place.
+        RegisterBase();
+        return;
+    }
+
+    // No container was selected up front: keep the historical behavior and
+    // register every codec chain.
+    spx_gst_register_container(SPX_GST_CONTAINER_ANY);
 #endif
 }
 
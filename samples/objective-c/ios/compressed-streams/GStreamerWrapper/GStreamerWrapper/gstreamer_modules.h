@@ -38,11 +38,38 @@ extern "C"
 }
 #endif
 
+// Container formats the wrapper can register decode chains for, mirroring the
+// app's SPXAudioStreamContainerFormat stream-format selection. The enum is
+// plain C so Objective-C callers can redeclare it without this header's
+// GStreamer dependency.
+typedef enum spx_gst_container_format
+{
+    SPX_GST_CONTAINER_ANY = 0,
+    SPX_GST_CONTAINER_MP3 = 1,
+    SPX_GST_CONTAINER_OGG_OPUS = 2,
+    SPX_GST_CONTAINER_FLAC = 3,
+    SPX_GST_CONTAINER_ALAW = 4,
+    SPX_GST_CONTAINER_MULAW = 5,
+    SPX_GST_CONTAINER_WAV = 6,
+} spx_gst_container_format;
+
+// Registers the base elements plus only the decode chain for one container
+// format, e.g. the Ogg/Opus chain for Opus or mpegaudioparse/mpg123 for MP3.
+// Call it from the app when the stream format is selected, before the SDK
+// initializes GStreamer; an app that uses a single codec then never pays
+// launch time or resident footprint for the others. Idempotent per chain;
+// exported with C linkage so Objective-C code can call it directly.
+extern "C" __attribute__((visibility ("default"))) void spx_gst_register_container(spx_gst_container_format format);
+
 namespace Microsoft {
 namespace CognitiveServices {
 namespace Speech {
 namespace Impl {
 
+// The SDK's initialization hook. When the app has already selected a
+// container through spx_gst_register_container, this only tops up the base
+// elements; otherwise it keeps the historical behavior and registers every
+// codec chain.
 __attribute__((visibility ("default"))) void spx_gst_init();
 
 } } } } // Microsoft::CognitiveServices::Speech::Impl